@@ -0,0 +1,115 @@
+#pragma once
+
+#include <fstream>
+
+namespace minskill::bench
+{
+using Clock = std::chrono::steady_clock;
+
+inline double elapsedMs(Clock::time_point start, Clock::time_point end = Clock::now())
+{
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// A field of /proc/self/status in kB, 0 where there is none
+inline size_t procStatusKb(std::string_view field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string   line;
+    while (std::getline(status, line))
+        if (line.starts_with(field) && line.size() > field.size() && line[field.size()] == ':')
+            return std::strtoull(line.c_str() + field.size() + 1, nullptr, 10);
+    return 0;
+}
+
+inline size_t peakRssKb()
+{
+    return procStatusKb("VmHWM");
+}
+
+inline size_t currentRssKb()
+{
+    return procStatusKb("VmRSS");
+}
+
+// Restarts the peak at the current resident size, so each run gets its own peak
+inline void resetPeakRss()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+}
+
+// Sorts values in place
+inline double percentile(std::vector<double>& values, double pct)
+{
+    if (values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    auto idx = (size_t)std::lround(pct / 100.0 * (double)(values.size() - 1));
+    return values[std::min(idx, values.size() - 1)];
+}
+
+// Comma separated numbers, as in --sizes 100,1000
+template <class T>
+std::vector<T> parseList(const std::string& str)
+{
+    std::vector<T>     result;
+    std::istringstream strstrm(str);
+    std::string        item;
+    while (std::getline(strstrm, item, ','))
+        if (!item.empty())
+            result.push_back((T)std::stod(item));
+    return result;
+}
+
+// --name value pairs and --flag switches
+class Args
+{
+public:
+    Args(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string_view arg = argv[i];
+            if (!arg.starts_with("--"))
+            {
+                unknown.emplace_back(arg);
+                continue;
+            }
+            arg.remove_prefix(2);
+            if (i + 1 < argc && !std::string_view(argv[i + 1]).starts_with("--"))
+                values[std::string(arg)] = argv[++i];
+            else
+                values[std::string(arg)] = "";
+        }
+    }
+
+    bool has(const std::string& name) const { return values.contains(name); }
+
+    std::string get(const std::string& name, std::string def) const
+    {
+        auto iter = values.find(name);
+        return iter != values.end() ? iter->second : def;
+    }
+
+    // otherwise a literal default would pick the number parsing template below
+    std::string get(const std::string& name, const char* def) const { return get(name, std::string(def)); }
+
+    template <class T>
+    T get(const std::string& name, T def) const
+    {
+        auto iter = values.find(name);
+        if (iter == values.end() || iter->second.empty())
+            return def;
+        if constexpr (std::is_floating_point_v<T>)
+            return (T)std::stod(iter->second);
+        else
+            return (T)std::stoll(iter->second);
+    }
+
+    std::vector<std::string> unknown;
+
+private:
+    std::map<std::string, std::string> values;
+};
+} // namespace minskill::bench
@@ -0,0 +1,227 @@
+// Draws synthetic perk trees on a headless ImGui context at several zoom & pan settings
+// and reports CPU time, vertices and draw commands per frame. With --baseline it fails
+// on frames slower or heavier than a previous run's results.
+#include "canvas.h"
+#include "file.h"
+#include "headless.h"
+#include "synthetic.h"
+
+#include "ImNodes/ImNodesEz.h"
+
+using namespace minskill;
+using namespace minskill::bench;
+
+enum class Pan
+{
+    Origin,  // first nodes at the canvas corner
+    Center,  // tree center in the middle of the canvas
+    Outside, // nothing visible
+};
+
+constexpr const char* pan_names[] = {"origin", "center", "outside"};
+
+struct Scenario
+{
+    size_t nodes;
+    float  zoom;
+    Pan    pan;
+
+    std::string key() const { return fmt::format("{}/{:.2f}/{}", nodes, zoom, pan_names[(int)pan]); }
+};
+
+struct Result
+{
+    Scenario scenario;
+    double   median_ms;
+    double   p95_ms;
+    double   draw_ms; // median of the menu's draw alone
+    int      vertices;
+    int      indices;
+    int      commands;
+};
+
+static void printUsage()
+{
+    fmt::print("Usage: canvas_bench [options]\n"
+               "  --sizes A,B,..   tree sizes in nodes (100,1000,10000)\n"
+               "  --zooms A,B,..   canvas zoom levels (0.2,1,2)\n"
+               "  --links X        average links per node (2)\n"
+               "  --frames N       timed frames per scenario (60)\n"
+               "  --warmup N       untimed frames per scenario (5)\n"
+               "  --out FILE       write results as csv\n"
+               "  --baseline FILE  compare with a csv written by --out\n"
+               "  --tolerance X    allowed slowdown & vertex growth over the baseline (0.25)\n"
+               "  --dir PATH       where to write the configs (temp directory)\n");
+}
+
+static void setView(SkillConfig& config, const Scenario& scenario, ImVec2 display)
+{
+    ImVec2 lo = {FLT_MAX, FLT_MAX}, hi = {-FLT_MAX, -FLT_MAX};
+    for (const auto& [num, perk_info] : config.perks)
+    {
+        lo = {std::min(lo.x, perk_info.pos.x), std::min(lo.y, perk_info.pos.y)};
+        hi = {std::max(hi.x, perk_info.pos.x), std::max(hi.y, perk_info.pos.y)};
+    }
+
+    CanvasPool::getSingleton()->acquire(config.path.string());
+    auto& canvas = ImNodes::Ez::GetState();
+    canvas.Zoom  = scenario.zoom;
+    switch (scenario.pan)
+    {
+        case Pan::Origin:
+            canvas.Offset = {-lo.x * scenario.zoom, -lo.y * scenario.zoom};
+            break;
+        case Pan::Center:
+        {
+            ImVec2 canvas_size = {display.x * (1 - tree_window_width), display.y};
+            canvas.Offset      = {canvas_size.x * 0.5f - (lo.x + hi.x) * 0.5f * scenario.zoom,
+                                  canvas_size.y * 0.5f - (lo.y + hi.y) * 0.5f * scenario.zoom};
+            break;
+        }
+        case Pan::Outside:
+            canvas.Offset = {-(hi.x + display.x * 4) * scenario.zoom, -(hi.y + display.y * 4) * scenario.zoom};
+            break;
+    }
+}
+
+static Result runScenario(HeadlessImGui& imgui, SkillConfig& config, const Scenario& scenario, size_t warmup, size_t frames)
+{
+    std::vector<double> frame_ms, draw_ms;
+    FrameStats          last;
+    for (size_t i = 0; i < warmup + frames; i++)
+    {
+        // the view is reapplied every frame so nothing drifts between scenarios
+        setView(config, scenario, imgui.display);
+        imgui.newFrame();
+        auto draw_time = drawSkillConfig(config, imgui.display);
+        last           = imgui.endFrame();
+        if (i < warmup)
+            continue;
+        frame_ms.push_back(last.frame_ms);
+        draw_ms.push_back(draw_time);
+    }
+    return {scenario, percentile(frame_ms, 50), percentile(frame_ms, 95), percentile(draw_ms, 50), last.vertices, last.indices, last.commands};
+}
+
+static std::map<std::string, Result> readBaseline(const fs::path& path)
+{
+    std::map<std::string, Result> baseline;
+    std::ifstream                 in(path);
+    std::string                   line;
+    std::getline(in, line); // header
+    while (std::getline(in, line))
+    {
+        std::istringstream strstrm(line);
+        std::string        key, field;
+        Result             result = {};
+        std::getline(strstrm, key, ',');
+        std::vector<double> fields;
+        while (std::getline(strstrm, field, ','))
+            fields.push_back(std::stod(field));
+        if (fields.size() < 6)
+            continue;
+        result.median_ms = fields[0];
+        result.p95_ms    = fields[1];
+        result.draw_ms   = fields[2];
+        result.vertices  = (int)fields[3];
+        result.indices   = (int)fields[4];
+        result.commands  = (int)fields[5];
+        baseline[key]    = result;
+    }
+    return baseline;
+}
+
+int main(int argc, char** argv)
+{
+    Args args(argc, argv);
+    if (args.has("help") || !args.unknown.empty())
+    {
+        printUsage();
+        return args.has("help") ? 0 : 1;
+    }
+
+    auto     sizes     = parseList<size_t>(args.get("sizes", "100,1000,10000"));
+    auto     zooms     = parseList<float>(args.get("zooms", "0.2,1,2"));
+    auto     frames    = std::max<size_t>(args.get<size_t>("frames", 60), 1);
+    auto     warmup    = args.get<size_t>("warmup", 5);
+    auto     tolerance = args.get<double>("tolerance", 0.25);
+    fs::path dir       = args.get("dir", (fs::temp_directory_path() / "minskill_canvas_bench").string());
+
+    spdlog::set_level(spdlog::level::warn);
+
+    StubGame stub;
+    setGame(&stub);
+    HeadlessImGui imgui;
+    // every tree keeps its own canvas, the pool would otherwise free them between scenarios
+    CanvasPool::getSingleton()->setCapacity(sizes.size());
+
+    fs::remove_all(dir);
+    std::vector<std::unique_ptr<SkillConfig>> configs;
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        SyntheticShape shape;
+        shape.files   = 1;
+        shape.nodes   = sizes[i];
+        shape.links   = args.get<double>("links", shape.links);
+        shape.seed    = (uint32_t)i + 1;
+        auto tree_dir = dir / fmt::format("n{}", sizes[i]);
+        writeSyntheticConfigs(tree_dir, shape, stub);
+
+        auto& config = *configs.emplace_back(std::make_unique<SkillConfig>());
+        config.slot  = i;
+        config.read(tree_dir / "customskill.bench0.config.txt");
+        config.name = fmt::format("Bench {}", sizes[i]); // tree windows must not share a name
+        if (!config.loaded)
+        {
+            fmt::print("Failed to load the {} node tree\n", sizes[i]);
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    fmt::print("{:<22} {:>10} {:>10} {:>10} {:>10} {:>10}\n", "nodes/zoom/pan", "frame ms", "p95 ms", "draw ms", "vertices", "commands");
+    for (size_t i = 0; i < sizes.size(); i++)
+        for (auto zoom : zooms)
+            for (size_t pan = 0; pan < std::size(pan_names); pan++)
+            {
+                auto& result = results.emplace_back(runScenario(imgui, *configs[i], {sizes[i], zoom, (Pan)pan}, warmup, frames));
+                fmt::print("{:<22} {:>10.3f} {:>10.3f} {:>10.3f} {:>10} {:>10}\n", result.scenario.key(), result.median_ms, result.p95_ms,
+                           result.draw_ms, result.vertices, result.commands);
+            }
+
+    if (args.has("out"))
+    {
+        std::ofstream out(args.get("out", ""), std::ios::trunc);
+        out << "scenario,median_ms,p95_ms,draw_ms,vertices,indices,commands\n";
+        for (const auto& result : results)
+            out << fmt::format("{},{:.4f},{:.4f},{:.4f},{},{},{}\n", result.scenario.key(), result.median_ms, result.p95_ms, result.draw_ms,
+                               result.vertices, result.indices, result.commands);
+    }
+
+    fs::remove_all(dir);
+    if (!args.has("baseline"))
+        return 0;
+
+    // frame times are noisy, vertex counts are not, both get the same headroom
+    auto   baseline    = readBaseline(args.get("baseline", ""));
+    size_t regressions = 0;
+    for (const auto& result : results)
+    {
+        auto iter = baseline.find(result.scenario.key());
+        if (iter == baseline.end())
+            continue;
+        const auto& base = iter->second;
+        if (result.median_ms > base.median_ms * (1 + tolerance))
+        {
+            fmt::print("REGRESSION {}: frame {:.3f} ms, baseline {:.3f} ms\n", result.scenario.key(), result.median_ms, base.median_ms);
+            regressions++;
+        }
+        if (result.vertices > base.vertices * (1 + tolerance))
+        {
+            fmt::print("REGRESSION {}: {} vertices, baseline {}\n", result.scenario.key(), result.vertices, base.vertices);
+            regressions++;
+        }
+    }
+    fmt::print("{} regressions against {}\n", regressions, args.get("baseline", ""));
+    return regressions > 0 ? 2 : 0;
+}
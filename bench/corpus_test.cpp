@@ -0,0 +1,88 @@
+// Loads every config in bench/corpus against StubGame and checks what the loader made of it.
+// A new corpus file needs an entry here, so its expected result is written down once.
+#include "file.h"
+#include "synthetic.h"
+
+using namespace minskill;
+using namespace minskill::bench;
+
+struct Expected
+{
+    std::string_view file;
+    bool             loaded;
+    size_t           perks;    // nodes left after disabled ones are dropped
+    size_t           problems; // Diagnostics::total
+};
+
+constexpr Expected expected[] = {
+    {"customskill.cycles.config.txt", true, 5, 0},
+    {"customskill.dangling.config.txt", true, 3, 0},
+    {"customskill.disabled_chain.config.txt", true, 0, 8},
+    {"customskill.disabled_flags.config.txt", true, 1, 0},
+    {"customskill.missing_globals.config.txt", false, 0, 1},
+    {"customskill.missing_name.config.txt", true, 1, 0},
+    {"customskill.multi_rank.config.txt", true, 3, 0},
+    {"customskill.node_keys.config.txt", true, 3, 0},
+    {"customskill.odd_links.config.txt", true, 5, 0},
+    {"customskill.unpositioned.config.txt", true, 4, 0},
+    {"customskill.wide_fan_in.config.txt", true, 16, 0},
+    {"customskill.wrong_type.config.txt", true, 0, 4},
+};
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        fmt::print("Usage: corpus_test CORPUS_DIR\n");
+        return 1;
+    }
+
+    spdlog::set_level(spdlog::level::off);
+    StubGame stub;
+    setGame(&stub);
+
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::directory_iterator(argv[1]))
+        if (entry.is_regular_file())
+            files.push_back(entry.path());
+    std::sort(files.begin(), files.end());
+
+    size_t failures = 0;
+    for (const auto& path : files)
+    {
+        auto name = path.filename().string();
+        auto iter = std::find_if(std::begin(expected), std::end(expected), [&](const Expected& exp) { return exp.file == name; });
+        if (iter == std::end(expected))
+        {
+            fmt::print("FAIL {}: no expected result\n", name);
+            failures++;
+            continue;
+        }
+
+        // each file on its own, forms registered for one must not help another
+        stub.clear();
+        registerConfigForms(path, stub);
+        SkillConfig config;
+        config.read(path);
+
+        Expected actual{iter->file, config.loaded, config.perks.size(), config.diagnostics.total()};
+        if (actual.loaded != iter->loaded || actual.perks != iter->perks || actual.problems != iter->problems)
+        {
+            fmt::print("FAIL {}: loaded {} perks {} problems {}, expected loaded {} perks {} problems {}\n", name, actual.loaded, actual.perks,
+                       actual.problems, iter->loaded, iter->perks, iter->problems);
+            failures++;
+        }
+        else
+            fmt::print("ok   {}\n", name);
+    }
+
+    for (const auto& exp : expected)
+        if (std::none_of(files.begin(), files.end(), [&](const fs::path& path) { return path.filename() == exp.file; }))
+        {
+            fmt::print("FAIL {}: missing from the corpus\n", exp.file);
+            failures++;
+        }
+
+    fmt::print("{} files, {} failed\n", files.size(), failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,32 @@
+// libFuzzer target for SkillConfig::read. Seed it with bench/corpus, forms referenced
+// by an input are registered on a stub game first so inputs get past the form lookup.
+#include "file.h"
+#include "synthetic.h"
+
+#include <unistd.h>
+
+using namespace minskill;
+using namespace minskill::bench;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    static StubGame stub;
+    static fs::path path = fs::temp_directory_path() / fmt::format("customskill.fuzz{}.config.txt", getpid());
+    static bool     init = [] {
+        spdlog::set_level(spdlog::level::off);
+        setGame(&stub);
+        return true;
+    }();
+    (void)init;
+
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data), (std::streamsize)size);
+    }
+    stub.clear();
+    registerConfigForms(path, stub);
+
+    SkillConfig config;
+    config.read(path);
+    return 0;
+}
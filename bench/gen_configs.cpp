@@ -0,0 +1,45 @@
+// Writes synthetic configs to a directory, for loading them in game or keeping
+// a shape that once made the loader slow.
+#include "synthetic.h"
+
+using namespace minskill;
+using namespace minskill::bench;
+
+static void printUsage()
+{
+    fmt::print("Usage: gen_configs --out PATH [options]\n"
+               "{}"
+               "  --presets       list the named shapes\n",
+               shape_usage);
+}
+
+int main(int argc, char** argv)
+{
+    Args args(argc, argv);
+    if (args.has("presets"))
+    {
+        for (const auto& name : presetNames())
+            fmt::print("{}\n", name);
+        return 0;
+    }
+    if (args.has("help") || !args.unknown.empty() || args.get("out", "").empty())
+    {
+        printUsage();
+        return args.has("help") ? 0 : 1;
+    }
+
+    auto shape = shapeFromArgs(args);
+    if (!shape)
+    {
+        fmt::print("Unknown preset {}, see --presets\n", args.get("preset", ""));
+        return 1;
+    }
+
+    // the forms only exist in the stub, in game the ids point at whatever the plugins hold
+    StubGame stub;
+    fs::path dir   = args.get("out", "");
+    auto     stats = writeSyntheticConfigs(dir, *shape, stub);
+    fmt::print("Wrote {} files, {} nodes, {} links, {} ranks, {} broken nodes, {:.1f} MB to {}\n",
+               stats.files, stats.nodes, stats.links, stats.ranks, stats.invalid, stats.bytes / 1e6, dir.string());
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "headless.h"
+#include "file.h"
+
+namespace minskill::bench
+{
+HeadlessImGui::HeadlessImGui(ImVec2 display) : display(display)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    auto& io       = ImGui::GetIO();
+    io.IniFilename = nullptr; // window placement comes from the benchmark, not from a previous run
+    io.LogFilename = nullptr;
+    io.DisplaySize = display;
+
+    // builds the atlas, the texture is never uploaded
+    unsigned char* pixels;
+    int            width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+HeadlessImGui::~HeadlessImGui()
+{
+    ImGui::DestroyContext();
+}
+
+void HeadlessImGui::newFrame(float delta)
+{
+    io().DisplaySize = display;
+    io().DeltaTime   = delta;
+    frame_start      = Clock::now();
+    ImGui::NewFrame();
+}
+
+FrameStats HeadlessImGui::endFrame()
+{
+    ImGui::Render();
+    FrameStats stats;
+    stats.frame_ms = elapsedMs(frame_start);
+
+    auto draw_data = ImGui::GetDrawData();
+    stats.vertices = draw_data->TotalVtxCount;
+    stats.indices  = draw_data->TotalIdxCount;
+    stats.lists    = draw_data->CmdListsCount;
+    for (int i = 0; i < draw_data->CmdListsCount; i++)
+        stats.commands += draw_data->CmdLists[i]->CmdBuffer.Size;
+    return stats;
+}
+
+double drawSkillConfig(SkillConfig& config, ImVec2 display)
+{
+    // the tree window is begun inside draw, so it can only be placed by name once it exists
+    auto tree_name = fmt::format("Perk Tree ({})", config.name);
+    ImGui::SetWindowPos(tree_name.c_str(), {display.x * tree_window_width, 0});
+    ImGui::SetWindowSize(tree_name.c_str(), {display.x * (1 - tree_window_width), display.y});
+
+    ImGui::SetNextWindowPos({0, 0});
+    ImGui::SetNextWindowSize({display.x * tree_window_width, display.y});
+    auto start = Clock::now();
+    if (ImGui::Begin("Minimalistic Custom Skill Menu"))
+        config.draw();
+    ImGui::End();
+    return elapsedMs(start);
+}
+} // namespace minskill::bench
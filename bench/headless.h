@@ -0,0 +1,45 @@
+#pragma once
+
+#include "benchutils.h"
+
+namespace minskill
+{
+struct SkillConfig;
+}
+
+namespace minskill::bench
+{
+struct FrameStats
+{
+    double frame_ms = 0; // NewFrame to Render
+    double draw_ms  = 0; // the menu's own draw calls
+    int    vertices = 0;
+    int    indices  = 0;
+    int    commands = 0; // draw commands over all lists
+    int    lists    = 0;
+};
+
+// ImGui context with no renderer or window. Fonts are built into the CPU side atlas and
+// draw data is only counted, so frames run the same code as in game without a GPU.
+class HeadlessImGui
+{
+public:
+    explicit HeadlessImGui(ImVec2 display = {1920, 1080});
+    ~HeadlessImGui();
+
+    ImGuiIO& io() { return ImGui::GetIO(); }
+
+    void       newFrame(float delta = 1.0f / 60);
+    FrameStats endFrame();
+
+    ImVec2 display;
+
+private:
+    Clock::time_point frame_start;
+};
+
+constexpr auto tree_window_width = 0.3f; // share of the display left to the config's own widgets
+
+// Draws a skill config the way the menu does, with its perk tree window pinned to the rest of the display
+double drawSkillConfig(SkillConfig& config, ImVec2 display);
+} // namespace minskill::bench
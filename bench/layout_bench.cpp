@@ -0,0 +1,90 @@
+// Times layeredLayout on random perk graphs of several sizes, the work SkillConfig::read
+// does for every config with nodes left to the automatic layout.
+#include "benchutils.h"
+#include "layout.h"
+
+#include <random>
+
+using namespace minskill;
+using namespace minskill::bench;
+
+using LinkMap = std::map<uint16_t, std::vector<uint16_t>>;
+
+static void printUsage()
+{
+    fmt::print("Usage: layout_bench [options]\n"
+               "  --sizes A,B,..   graph sizes in nodes (100,1000,10000)\n"
+               "  --links X        average links per node, to later nodes nearby (2)\n"
+               "  --backlinks X    share of nodes linked to an earlier one, making cycles (0)\n"
+               "  --iterations N   layouts to time per size (9)\n"
+               "  --seed N         generator seed (1)\n");
+}
+
+// Same link shape as the synthetic configs, node numbers start at 1
+static LinkMap randomGraph(size_t nodes, double links, double backlinks, std::mt19937& rng)
+{
+    auto                                   span = std::max<size_t>(4, (size_t)std::sqrt((double)nodes) * 2);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_int_distribution<size_t>  links_dist(0, (size_t)std::lround(links * 2));
+
+    LinkMap graph;
+    for (size_t num = 1; num <= nodes; num++)
+    {
+        auto& outs = graph[(uint16_t)num];
+        if (num < nodes)
+        {
+            std::uniform_int_distribution<size_t> target_dist(num + 1, std::min(nodes, num + span));
+            for (auto cts = links_dist(rng); cts > 0; cts--)
+                outs.push_back((uint16_t)target_dist(rng));
+        }
+        if (num > 1 && chance(rng) < backlinks)
+            outs.push_back((uint16_t)std::uniform_int_distribution<size_t>(1, num - 1)(rng));
+    }
+    return graph;
+}
+
+int main(int argc, char** argv)
+{
+    Args args(argc, argv);
+    if (args.has("help") || !args.unknown.empty())
+    {
+        printUsage();
+        return args.has("help") ? 0 : 1;
+    }
+
+    auto sizes      = parseList<size_t>(args.get("sizes", "100,1000,10000"));
+    auto links      = args.get<double>("links", 2.0);
+    auto backlinks  = args.get<double>("backlinks", 0.0);
+    auto iterations = std::max<size_t>(args.get<size_t>("iterations", 9), 1);
+    auto seed       = args.get<uint32_t>("seed", 1);
+
+    fmt::print("{:>8} {:>8} {:>10} {:>10} {:>10} {:>12}\n", "nodes", "links", "median ms", "min ms", "max ms", "nodes/ms");
+    for (auto size : sizes)
+    {
+        size = std::clamp<size_t>(size, 1, UINT16_MAX);
+        std::mt19937 rng(seed);
+        auto         graph    = randomGraph(size, links, backlinks, rng);
+        size_t       link_cts = 0;
+        for (const auto& [num, outs] : graph)
+            link_cts += outs.size();
+
+        std::vector<double> times;
+        size_t              placed = 0;
+        for (size_t iter = 0; iter < iterations; iter++)
+        {
+            auto start  = Clock::now();
+            auto layout = layeredLayout(graph);
+            times.push_back(elapsedMs(start));
+            placed = layout.size();
+        }
+        if (placed != graph.size())
+        {
+            fmt::print("Layout of {} nodes placed {}\n", graph.size(), placed);
+            return 1;
+        }
+
+        auto median = percentile(times, 50);
+        fmt::print("{:>8} {:>8} {:>10.3f} {:>10.3f} {:>10.3f} {:>12.0f}\n", size, link_cts, median, times.front(), times.back(), size / median);
+    }
+    return 0;
+}
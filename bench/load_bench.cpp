@@ -0,0 +1,153 @@
+// Loads synthetic configs through ConfigReader against StubGame and reports
+// throughput, time per trace zone and peak memory.
+#include "benchutils.h"
+#include "file.h"
+#include "manifest.h"
+#include "synthetic.h"
+#include "trace.h"
+
+using namespace minskill;
+using namespace minskill::bench;
+
+static void printUsage()
+{
+    fmt::print("Usage: load_bench [options]\n"
+               "{}"
+               "  --corpus PATH   load the hand written configs in PATH instead of generating\n"
+               "  --unrelated N   other plugins' files to put next to the configs (0)\n"
+               "  --cold          parse every config each run instead of reusing the manifest\n"
+               "  --iterations N  loads to time (5)\n"
+               "  --dir PATH      where to write the configs (temp directory)\n"
+               "  --keep          keep the generated configs\n"
+               "  --verbose       keep the loader's log output\n"
+               "  --presets       list the named shapes\n",
+               shape_usage);
+}
+
+int main(int argc, char** argv)
+{
+    Args args(argc, argv);
+    if (args.has("help") || !args.unknown.empty())
+    {
+        printUsage();
+        return args.has("help") ? 0 : 1;
+    }
+    if (args.has("presets"))
+    {
+        for (const auto& name : presetNames())
+            fmt::print("{}\n", name);
+        return 0;
+    }
+
+    auto shape = shapeFromArgs(args);
+    if (!shape)
+    {
+        fmt::print("Unknown preset {}, see --presets\n", args.get("preset", ""));
+        return 1;
+    }
+    // a few broken nodes unless asked otherwise, as in real installs
+    auto broken_args = {"preset", "invalid", "missing", "wrong-type", "disabled", "dangling"};
+    if (std::none_of(broken_args.begin(), broken_args.end(), [&](const char* name) { return args.has(name); }))
+        shape->setInvalid(0.05);
+    auto     iterations = std::max<size_t>(args.get<size_t>("iterations", 5), 1);
+    fs::path dir        = args.get("dir", (fs::temp_directory_path() / "minskill_load_bench").string());
+
+    spdlog::set_level(args.has("verbose") ? spdlog::level::info : spdlog::level::off);
+
+    StubGame       stub;
+    SyntheticStats stats;
+    setGame(&stub);
+    if (args.has("corpus"))
+    {
+        // the corpus is read in place, so it is never removed
+        dir = args.get("corpus", "");
+        for (const auto& entry : fs::directory_iterator(dir))
+            if (entry.is_regular_file())
+            {
+                registerConfigForms(entry.path(), stub);
+                stats.files++;
+                stats.bytes += entry.file_size();
+            }
+        fmt::print("Corpus of {} files, {:.1f} kB\n", stats.files, stats.bytes / 1e3);
+    }
+    else
+    {
+        fs::remove_all(dir);
+        auto gen_start = Clock::now();
+        stats          = writeSyntheticConfigs(dir, *shape, stub);
+        fmt::print("Generated {} files, {} nodes, {} links, {} ranks, {} broken nodes, {:.1f} MB in {:.0f} ms\n",
+                   stats.files, stats.nodes, stats.links, stats.ranks, stats.invalid, stats.bytes / 1e6, elapsedMs(gen_start));
+
+        // the config folder is shared with other NetScriptFramework plugins
+        auto unrelated = args.get<size_t>("unrelated", 0);
+        for (size_t i = 0; i < unrelated; i++)
+            std::ofstream(dir / fmt::format("{}.Plugin{}.config.txt", i % 2 ? "Other" : "customskill_not", i));
+    }
+
+    // every run starts like the game does, from the manifest the previous one wrote
+    auto manifest      = ConfigManifest::getSingleton();
+    auto manifest_file = fs::temp_directory_path() / "minskill_load_bench.configs.bin";
+    fs::remove(manifest_file);
+    manifest->setFile(manifest_file);
+
+    auto                                            reader = ConfigReader::getSingleton();
+    auto                                            tracer = TraceRecorder::getSingleton();
+    std::vector<double>                             wall_ms;
+    std::map<std::string_view, std::vector<double>> zone_ms;
+    size_t                                          peak_kb = 0, base_kb = currentRssKb();
+    for (size_t iter = 0; iter < iterations; iter++)
+    {
+        manifest->clear();
+        if (args.has("cold"))
+            fs::remove(manifest_file);
+        resetPeakRss();
+        auto start_kb = currentRssKb();
+
+        tracer->start();
+        auto start = Clock::now();
+        reader->readAllConfig(dir);
+        wall_ms.push_back(elapsedMs(start));
+        tracer->stop(false);
+
+        auto end_peak_kb = peakRssKb();
+        peak_kb          = std::max(peak_kb, end_peak_kb > start_kb ? end_peak_kb - start_kb : 0);
+        for (const auto& [name, total] : tracer->totals())
+            zone_ms[name].push_back(total.total_us / 1000.0);
+    }
+
+    manifest->clear();
+    fs::remove(manifest_file);
+
+    size_t loaded = 0, perks = 0;
+    for (const auto& config : reader->configs)
+        if (config.loaded)
+        {
+            loaded++;
+            perks += config.perks.size();
+        }
+
+    // the first load parses everything & writes the manifest, so the median is the steady state
+    auto        first  = wall_ms.front();
+    auto        median = percentile(wall_ms, 50);
+    const auto& scan   = manifest->last_scan;
+    fmt::print("Loaded {}/{} configs with {} perks\n", loaded, reader->configs.size(), perks);
+    fmt::print("Last scan: {} entries listed, {} configs, {} parsed, {} failed\n", scan.entries, scan.configs, scan.parsed, scan.failed);
+    fmt::print("Load time: first {:.2f} ms, median {:.2f} ms, min {:.2f} ms, max {:.2f} ms over {} runs\n",
+               first, median, wall_ms.front(), wall_ms.back(), wall_ms.size());
+    fmt::print("Throughput: {:.0f} files/s, {:.0f} nodes/s, {:.1f} MB/s\n",
+               stats.files / median * 1000, stats.nodes / median * 1000, stats.bytes / 1e6 / median * 1000);
+    fmt::print("Memory: peak +{:.1f} MB during a load, {:.1f} MB resident after (started at {:.1f} MB)\n",
+               peak_kb / 1024.0, currentRssKb() / 1024.0, base_kb / 1024.0);
+
+    fmt::print("\n{:<20} {:>10} {:>8}\n", "Phase", "median ms", "share");
+    std::vector<std::pair<double, std::string_view>> phases;
+    for (auto& [name, times] : zone_ms)
+        phases.push_back({percentile(times, 50), name});
+    std::sort(phases.rbegin(), phases.rend());
+    for (const auto& [time, name] : phases)
+        fmt::print("{:<20} {:>10.2f} {:>7.1f}%\n", name, time, time / median * 100);
+
+    if (!args.has("keep") && !args.has("corpus"))
+        fs::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,86 @@
+// Times the level-up check UpdateHook runs every frame: the per-config loop it replaced
+// against LevelUpWatcher at a given interval, over synthetic configs in StubGame.
+#include "benchutils.h"
+#include "file.h"
+#include "notify.h"
+#include "synthetic.h"
+
+using namespace minskill;
+using namespace minskill::bench;
+
+static void printUsage()
+{
+    fmt::print("Usage: notify_bench [options]\n"
+               "  --files N        config files (64)\n"
+               "  --frames N       frames to time (1000000)\n"
+               "  --interval N     watcher frames between checks (10)\n"
+               "  --level-every N  frames between level ups, 0 for none (600)\n"
+               "  --dir PATH       where to write the configs (temp directory)\n");
+}
+
+// UpdateHook before LevelUpWatcher, with the notification going through the game interface
+static void checkEveryConfig(const std::vector<SkillConfig>& configs)
+{
+    for (const auto& skill_config : configs)
+        if (skill_config.loaded)
+        {
+            auto val = std::lround(game().getGlobal(skill_config.g_show_lvl_up));
+            if (val > 0)
+            {
+                game().notify(fmt::format("Skill \"{}\" has reached lvl. {}", skill_config.name, val), "UISkillIncreaseSD");
+                game().setGlobal(skill_config.g_show_lvl_up, 0);
+            }
+        }
+}
+
+int main(int argc, char** argv)
+{
+    Args args(argc, argv);
+    if (args.has("help") || !args.unknown.empty())
+    {
+        printUsage();
+        return args.has("help") ? 0 : 1;
+    }
+
+    SyntheticShape shape;
+    shape.files = args.get<size_t>("files", 64);
+    shape.nodes = 8;
+
+    auto     frames  = std::max<size_t>(args.get<size_t>("frames", 1000000), 1);
+    auto     every   = args.get<size_t>("level-every", 600);
+    fs::path dir     = args.get("dir", (fs::temp_directory_path() / "minskill_notify_bench").string());
+    auto     watcher = LevelUpWatcher::getSingleton();
+    watcher->setInterval(args.get<uint32_t>("interval", 10));
+
+    spdlog::set_level(spdlog::level::off);
+    StubGame stub;
+    setGame(&stub);
+    fs::remove_all(dir);
+    writeSyntheticConfigs(dir, shape, stub);
+    auto reader = ConfigReader::getSingleton();
+    reader->readAllConfig(dir);
+    fs::remove_all(dir);
+    const auto& configs = reader->configs;
+    watcher->init(configs);
+
+    auto run = [&](const char* name, auto&& check) {
+        auto start = Clock::now();
+        for (size_t frame = 1; frame <= frames; frame++)
+        {
+            if (every > 0 && frame % every == 0)
+            {
+                const auto& config = configs[(frame / every) % configs.size()];
+                if (config.loaded)
+                    stub.setGlobal(config.g_show_lvl_up, 25);
+            }
+            check();
+        }
+        auto total_ms = elapsedMs(start);
+        fmt::print("{:<10} {:>8.1f} ns per frame\n", name, total_ms * 1e6 / frames);
+    };
+
+    fmt::print("{} configs, {} frames\n", configs.size(), frames);
+    run("per config", [&]() { checkEveryConfig(configs); });
+    run("watcher", [&]() { watcher->update(); });
+    return 0;
+}
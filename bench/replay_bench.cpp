@@ -0,0 +1,329 @@
+// Replays menu input recorded in game (Record Input) on a headless ImGui context against
+// StubGame, and reports per-frame timing and allocations. Runs of two builds over the same
+// recording can be compared with --out and --baseline.
+#include "canvas.h"
+#include "commands.h"
+#include "file.h"
+#include "headless.h"
+#include "perfstats.h"
+#include "replay.h"
+#include "stubgame.h"
+
+#include "ImNodes/ImNodesEz.h"
+
+#include <numeric>
+
+using namespace minskill;
+using namespace minskill::bench;
+
+// Allocations through new and through ImGui's allocator, counted on all threads
+static std::atomic<size_t> alloc_count = 0;
+static std::atomic<size_t> alloc_bytes = 0;
+
+static void* countedAlloc(size_t size)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+    if (auto ptr = countedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+constexpr uint32_t global_base = 0x800;
+constexpr uint32_t perk_base   = 0x1000;
+
+struct FrameResult
+{
+    FrameStats stats;
+    double     draw_ms;
+    double     game_ms; // command queue & snapshot work done on the game thread in game
+    size_t     allocs;
+    size_t     bytes;
+};
+
+static void printUsage()
+{
+    fmt::print("Usage: replay_bench RECORDING [options]\n"
+               "  --out FILE       write per-frame results as csv\n"
+               "  --baseline FILE  compare with a csv written by --out\n"
+               "  --tolerance X    allowed growth over the baseline (0.25)\n"
+               "  --dir PATH       where to write the rebuilt configs (temp directory)\n");
+}
+
+// Writes a config whose forms resolve to the recorded ranks and globals in stub
+static fs::path rebuildConfig(const RecordedConfig& recorded, size_t idx, const fs::path& dir, StubGame& stub)
+{
+    auto path   = dir / fmt::format("customskill.replay{}.config.txt", idx);
+    auto plugin = fmt::format("Replay{}.esp", idx);
+
+    std::ofstream out(path, std::ios::trunc);
+    out << fmt::format("Name = \"{}\"\nDescription = \"\"\n", idx);
+    if (!recorded.loaded)
+        return path; // fails to load like it did in game
+
+    std::vector<std::pair<const char*, float>> globals = {{"Level", recorded.skill_lvl}, {"Ratio", recorded.lvl_ratio}, {"ShowLevelup", 0.0f}};
+    if (recorded.has_perk_pts)
+        globals.push_back({"PerkPoints", recorded.perk_pts});
+    else
+        stub.setPerkPoints(std::lround(recorded.perk_pts));
+    if (recorded.has_legend)
+        globals.push_back({"Legendary", recorded.legend_cts});
+    for (uint32_t i = 0; i < globals.size(); i++)
+    {
+        stub.addGlobal(plugin, global_base + i, globals[i].second);
+        out << fmt::format("{0}File = \"{1}\"\n{0}Id = 0x{2:X}\n", globals[i].first, plugin, global_base + i);
+    }
+
+    uint32_t next_id = perk_base;
+    for (const auto& perk : recorded.perks)
+    {
+        PerkHandle prev = nullptr;
+        for (size_t rank = 0; rank < perk.ranks.size(); rank++)
+        {
+            const auto& recorded_rank = perk.ranks[rank];
+            prev                      = stub.addPerk(plugin, next_id + (uint32_t)rank, recorded_rank.name,
+                                                     {recorded_rank.skill_req, recorded_rank.legend_req, recorded_rank.other_conds}, prev);
+
+            auto stub_perk       = stub.perk(prev);
+            stub_perk->desc      = recorded_rank.desc;
+            stub_perk->conds_met = recorded_rank.conds_met;
+            stub_perk->owned     = rank < perk.owned;
+        }
+
+        std::string links;
+        for (auto link : perk.links)
+            links += fmt::format("{}{}", links.empty() ? "" : ", ", link);
+        out << fmt::format("\n[Node{}]\nEnable = true\nPerkFile = \"{}\"\nPerkId = 0x{:X}\nLinks = \"{}\"\n", perk.num, plugin, next_id, links);
+        next_id += (uint32_t)perk.ranks.size();
+    }
+    return path;
+}
+
+static void loadRecording(const Recording& recording, const fs::path& dir, StubGame& stub)
+{
+    auto reader = ConfigReader::getSingleton();
+    reader->configs.clear();
+    fs::create_directories(dir);
+    for (size_t i = 0; i < recording.configs.size(); i++)
+    {
+        const auto& recorded = recording.configs[i];
+        SkillConfig config;
+        config.slot = i;
+        config.read(rebuildConfig(recorded, i, dir, stub));
+        config.name = recorded.name;
+        config.desc = recorded.desc;
+        for (const auto& perk : recorded.perks)
+            if (auto iter = config.perks.find(perk.num); iter != config.perks.end())
+            {
+                iter->second.pos         = perk.pos;
+                iter->second.default_pos = perk.default_pos;
+                iter->second.selected    = perk.selected;
+            }
+        reader->configs.push_back(std::move(config));
+    }
+    reader->buildSearchIndex();
+    reader->use_list = recording.use_list;
+    if (recording.use_list)
+        reader->list_selected = recording.shown;
+    else
+        reader->jump_config = recording.shown;
+    GlobalSnapshot::getSingleton()->init(reader->configs);
+
+    // canvases start from the recorded views, as they would from the view store in game
+    CanvasPool::getSingleton()->setCapacity(std::max<size_t>(recording.configs.size(), 1));
+    for (size_t i = 0; i < recording.configs.size(); i++)
+    {
+        CanvasPool::getSingleton()->acquire(reader->configs[i].path.string());
+        ImNodes::Ez::GetState().Zoom   = recording.configs[i].zoom;
+        ImNodes::Ez::GetState().Offset = recording.configs[i].offset;
+    }
+}
+
+static void applyInput(ImGuiIO& io, const InputFrame& frame, const InputFrame& prev)
+{
+    io.AddMousePosEvent(frame.mouse.x, frame.mouse.y);
+    for (int i = 0; i < 5; i++)
+        if ((frame.buttons ^ prev.buttons) & (1 << i))
+            io.AddMouseButtonEvent(i, frame.buttons & (1 << i));
+    if (frame.wheel != 0 || frame.wheel_h != 0)
+        io.AddMouseWheelEvent(frame.wheel_h, frame.wheel);
+    const std::pair<InputMod, ImGuiKey> mods[] = {{InputMod_Ctrl, ImGuiMod_Ctrl}, {InputMod_Shift, ImGuiMod_Shift}, {InputMod_Alt, ImGuiMod_Alt}, {InputMod_Super, ImGuiMod_Super}};
+    for (const auto& [mod, key] : mods)
+        if ((frame.mods ^ prev.mods) & mod)
+            io.AddKeyEvent(key, frame.mods & mod);
+}
+
+struct Summary
+{
+    double median_ms = 0;
+    double p95_ms    = 0;
+    double max_ms    = 0;
+    double allocs    = 0; // mean per frame
+    double bytes     = 0; // mean per frame
+};
+
+static Summary summarize(std::vector<double> frame_ms, const std::vector<double>& allocs, const std::vector<double>& bytes)
+{
+    Summary summary;
+    if (frame_ms.empty())
+        return summary;
+    summary.median_ms = percentile(frame_ms, 50);
+    summary.p95_ms    = percentile(frame_ms, 95);
+    summary.max_ms    = frame_ms.back();
+    for (size_t i = 0; i < allocs.size(); i++)
+    {
+        summary.allocs += allocs[i] / allocs.size();
+        summary.bytes += bytes[i] / bytes.size();
+    }
+    return summary;
+}
+
+static std::optional<Summary> readBaseline(const fs::path& path)
+{
+    std::ifstream in(path);
+    if (!in)
+        return std::nullopt;
+    std::string line;
+    std::getline(in, line); // header
+    std::vector<double> frame_ms, allocs, bytes;
+    while (std::getline(in, line))
+    {
+        // frame,frame_ms,draw_ms,game_ms,allocs,bytes,vertices,commands
+        std::vector<double> fields;
+        std::istringstream  strstrm(line);
+        std::string         field;
+        while (std::getline(strstrm, field, ','))
+            fields.push_back(std::stod(field));
+        if (fields.size() < 6)
+            continue;
+        frame_ms.push_back(fields[1]);
+        allocs.push_back(fields[4]);
+        bytes.push_back(fields[5]);
+    }
+    return summarize(frame_ms, allocs, bytes);
+}
+
+int main(int argc, char** argv)
+{
+    Args args(argc, argv);
+    if (args.has("help") || args.unknown.size() != 1)
+    {
+        printUsage();
+        return args.has("help") ? 0 : 1;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    auto recording = readRecording(args.unknown.front());
+    if (!recording)
+        return 1;
+    auto     tolerance = args.get<double>("tolerance", 0.25);
+    fs::path dir       = args.get("dir", (fs::temp_directory_path() / "minskill_replay_bench").string());
+
+    // ImGui allocates through its own functions, which have to be set before the context exists
+    ImGui::SetAllocatorFunctions([](size_t size, void*) { return countedAlloc(size); }, [](void* ptr, void*) { std::free(ptr); });
+    HeadlessImGui imgui(recording->display);
+    imgui.io().ConfigInputTrickleEventQueue = false; // every recorded frame's input lands in that frame
+    ImGui::LoadIniSettingsFromMemory(recording->ini.c_str(), recording->ini.size());
+
+    StubGame stub;
+    setGame(&stub);
+    fs::remove_all(dir);
+    loadRecording(*recording, dir, stub);
+
+    std::vector<FrameResult> results;
+    InputFrame               prev;
+    for (const auto& frame : recording->frames)
+    {
+        applyInput(imgui.io(), frame, prev);
+        prev = frame;
+
+        auto start_allocs = alloc_count.load(std::memory_order_relaxed);
+        auto start_bytes  = alloc_bytes.load(std::memory_order_relaxed);
+        imgui.newFrame(frame.delta > 0 ? frame.delta : 1.0f / 60);
+        auto draw_start = Clock::now();
+        if (ImGui::Begin("Minimalistic Custom Skill Menu"))
+            ConfigReader::getSingleton()->draw();
+        ImGui::End();
+        PerfStats::getSingleton()->draw();
+        auto draw_ms = elapsedMs(draw_start);
+        auto stats   = imgui.endFrame();
+        auto allocs  = alloc_count.load(std::memory_order_relaxed) - start_allocs;
+        auto bytes   = alloc_bytes.load(std::memory_order_relaxed) - start_bytes;
+
+        auto game_start = Clock::now();
+        CommandQueue::getSingleton()->drain();
+        GlobalSnapshot::getSingleton()->sample();
+        results.push_back({stats, draw_ms, elapsedMs(game_start), allocs, bytes});
+    }
+
+    std::vector<double> frame_ms, allocs, bytes;
+    for (const auto& result : results)
+    {
+        frame_ms.push_back(result.stats.frame_ms);
+        allocs.push_back((double)result.allocs);
+        bytes.push_back((double)result.bytes);
+    }
+    auto summary = summarize(frame_ms, allocs, bytes);
+    fmt::print("Replayed {} frames over {} configs\n", results.size(), recording->configs.size());
+    fmt::print("Frame time: median {:.3f} ms, p95 {:.3f} ms, max {:.3f} ms\n", summary.median_ms, summary.p95_ms, summary.max_ms);
+    fmt::print("Allocations per frame: {:.1f} ({:.1f} KB)\n", summary.allocs, summary.bytes / 1024);
+
+    std::vector<size_t> slowest(results.size());
+    std::iota(slowest.begin(), slowest.end(), 0);
+    std::sort(slowest.begin(), slowest.end(), [&](auto a, auto b) { return results[a].stats.frame_ms > results[b].stats.frame_ms; });
+    slowest.resize(std::min<size_t>(slowest.size(), 5));
+    for (auto idx : slowest)
+        fmt::print("  frame {:>6}: {:.3f} ms, {} allocations, {} vertices\n", idx, results[idx].stats.frame_ms, results[idx].allocs, results[idx].stats.vertices);
+
+    if (args.has("out"))
+    {
+        std::ofstream out(args.get("out", ""), std::ios::trunc);
+        out << "frame,frame_ms,draw_ms,game_ms,allocs,bytes,vertices,commands\n";
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const auto& result = results[i];
+            out << fmt::format("{},{:.4f},{:.4f},{:.4f},{},{},{},{}\n", i, result.stats.frame_ms, result.draw_ms, result.game_ms, result.allocs,
+                               result.bytes, result.stats.vertices, result.stats.commands);
+        }
+    }
+
+    fs::remove_all(dir);
+    if (!args.has("baseline"))
+        return 0;
+
+    auto baseline = readBaseline(args.get("baseline", ""));
+    if (!baseline)
+    {
+        fmt::print("Failed to read baseline {}\n", args.get("baseline", ""));
+        return 1;
+    }
+    size_t regressions = 0;
+    auto   check       = [&](const char* metric, double value, double base) {
+        fmt::print("{:<12} {:>12.3f} baseline {:>12.3f}\n", metric, value, base);
+        if (value > base * (1 + tolerance))
+        {
+            fmt::print("REGRESSION {}\n", metric);
+            regressions++;
+        }
+    };
+    check("median ms", summary.median_ms, baseline->median_ms);
+    check("p95 ms", summary.p95_ms, baseline->p95_ms);
+    check("allocs", summary.allocs, baseline->allocs);
+    check("bytes", summary.bytes, baseline->bytes);
+    return regressions > 0 ? 2 : 0;
+}
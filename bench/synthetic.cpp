@@ -0,0 +1,259 @@
+#include "synthetic.h"
+
+#include <fstream>
+#include <random>
+#include "toml++/toml.h"
+
+namespace minskill::bench
+{
+constexpr uint32_t global_base = 0x800;  // level, ratio, show level up, perk points, legendary
+constexpr uint32_t perk_base   = 0x1000; // ranks of a perk take consecutive ids
+constexpr size_t   max_nodes   = 0xFF00; // leaves room for dangling links within uint16_t
+
+enum class Invalid
+{
+    None,
+    MissingForm,
+    WrongFormType,
+    Disabled,
+    DanglingLink,
+};
+
+// all valid to the loader, which splits on commas and skips blanks
+constexpr const char* odd_separators[] = {",", " , ", ",,", "\t,", ",\t ", " ,, "};
+
+const std::pair<const char*, SyntheticShape> presets[] = {
+    {"deep_chain", {.files = 1, .nodes = 4000, .links = 0, .chain = 1}},
+    {"disabled_chain", {.files = 1, .nodes = 4000, .links = 0, .chain = 1, .missing_first = true}},
+    {"wide_fan_in", {.files = 1, .nodes = 4000, .links = 0, .hubs = 1, .fan_in = 1}},
+    {"cycles", {.files = 1, .nodes = 2000, .backlinks = 0.3}},
+    {"many_ranks", {.files = 1, .nodes = 1000, .max_ranks = 20}},
+    {"broken_forms", {.files = 1, .nodes = 2000, .missing = 0.3, .wrong_type = 0.3}},
+    {"dangling", {.files = 1, .nodes = 2000, .dangling = 0.5}},
+    {"odd_links", {.files = 1, .nodes = 2000, .links = 4, .odd_spacing = 1}},
+    {"unpositioned", {.files = 1, .nodes = 2000, .positioned = false}},
+    {"many_files", {.files = 500, .nodes = 20}},
+};
+
+void SyntheticShape::setInvalid(double share)
+{
+    missing = wrong_type = disabled = dangling = share / 4;
+}
+
+static std::string formatLinks(const std::vector<size_t>& targets, bool odd, std::mt19937& rng)
+{
+    std::string links;
+    if (!odd)
+    {
+        for (auto target : targets)
+            links += fmt::format("{}{}", links.empty() ? "" : ", ", target);
+        return links;
+    }
+
+    std::uniform_int_distribution<size_t> sep_dist(0, std::size(odd_separators) - 1);
+    links = " ";
+    for (auto target : targets)
+        links += fmt::format("{}{}", target, odd_separators[sep_dist(rng)]);
+    return links;
+}
+
+static SyntheticStats writeConfig(const fs::path& path, size_t file_idx, const SyntheticShape& shape, std::mt19937& rng, StubGame& stub)
+{
+    SyntheticStats stats;
+    auto           plugin = fmt::format("Bench{}.esp", file_idx);
+    for (uint32_t i = 0; i < 5; i++)
+        stub.addGlobal(plugin, global_base + i, i == 3 ? 10.0f : 0.0f);
+
+    std::ofstream out(path, std::ios::trunc);
+    out << fmt::format("Name = \"Bench Skill {}\"\n", file_idx);
+    out << fmt::format("Description = \"Synthetic skill with {} nodes.\"\n", shape.nodes);
+    const char* global_keys[] = {"Level", "Ratio", "ShowLevelup", "PerkPoints", "Legendary"};
+    for (uint32_t i = 0; i < 5; i++)
+        out << fmt::format("{0}File = \"{1}\"\n{0}Id = 0x{2:X}\n", global_keys[i], plugin, global_base + i);
+
+    auto                                   nodes = std::min<size_t>(shape.nodes, max_nodes);
+    auto                                   hubs  = std::min(shape.hubs, nodes);
+    auto                                   span  = std::max<size_t>(4, (size_t)std::sqrt((double)nodes) * 2); // how far ahead links reach
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::uniform_int_distribution<size_t>  ranks_dist(1, std::max<size_t>(shape.max_ranks, 1));
+    std::uniform_int_distribution<size_t>  links_dist(0, (size_t)std::lround(shape.links * 2));
+    uint32_t                               next_id = perk_base;
+    std::vector<size_t>                    targets;
+
+    auto link = [&](size_t target) {
+        if (std::find(targets.begin(), targets.end(), target) == targets.end())
+            targets.push_back(target);
+    };
+
+    for (size_t num = 1; num <= nodes; num++)
+    {
+        // one roll picks at most one kind of breakage, in the order of the shares
+        auto invalid = Invalid::None;
+        auto roll    = chance(rng);
+        if ((roll -= shape.missing) < 0)
+            invalid = Invalid::MissingForm;
+        else if ((roll -= shape.wrong_type) < 0)
+            invalid = Invalid::WrongFormType;
+        else if ((roll -= shape.disabled) < 0)
+            invalid = Invalid::Disabled;
+        else if ((roll -= shape.dangling) < 0)
+            invalid = Invalid::DanglingLink;
+        if (num == 1 && shape.missing_first)
+            invalid = Invalid::MissingForm;
+        if (invalid != Invalid::None)
+            stats.invalid++;
+
+        auto       ranks   = ranks_dist(rng);
+        auto       perk_id = next_id;
+        PerkHandle prev    = nullptr;
+        if (invalid != Invalid::MissingForm)
+            for (size_t rank = 0; rank < ranks; rank++)
+                prev = stub.addPerk(plugin, next_id + (uint32_t)rank, fmt::format("Bench Perk {}-{} Rank {}", file_idx, num, rank + 1),
+                                    {(long)(num % 100), 0, false}, prev);
+        next_id += (uint32_t)ranks;
+        stats.ranks += ranks;
+
+        targets.clear();
+        if (num < nodes)
+        {
+            auto link_cts = links_dist(rng);
+            for (size_t i = 0; i < link_cts; i++)
+                link(std::uniform_int_distribution<size_t>(num + 1, std::min(nodes, num + span))(rng));
+            if (chance(rng) < shape.chain)
+                link(num + 1);
+        }
+        // hubs are the last nodes, so fan-in links still point forward
+        if (num <= nodes - hubs && chance(rng) < shape.fan_in)
+            link(std::uniform_int_distribution<size_t>(nodes - hubs + 1, nodes)(rng));
+        if (num > 1 && chance(rng) < shape.backlinks)
+            link(std::uniform_int_distribution<size_t>(num > span ? num - span : 1, num - 1)(rng));
+        stats.links += targets.size();
+        if (invalid == Invalid::DanglingLink)
+            targets.push_back(nodes + 1 + num % 64);
+
+        out << fmt::format("\n[Node{}]\n", num);
+        out << fmt::format("Enable = {}\n", invalid != Invalid::Disabled);
+        out << fmt::format("PerkFile = \"{}\"\n", plugin);
+        out << fmt::format("PerkId = 0x{:X}\n", invalid == Invalid::WrongFormType ? global_base : perk_id);
+        if (shape.positioned)
+            out << fmt::format("GridX = {}\nGridY = {}\n", num % 16, num / 16);
+        out << fmt::format("Links = \"{}\"\n", formatLinks(targets, chance(rng) < shape.odd_spacing, rng));
+        stats.nodes++;
+    }
+    out.close();
+
+    stats.files = 1;
+    stats.bytes = fs::file_size(path);
+    return stats;
+}
+
+SyntheticStats writeSyntheticConfigs(const fs::path& dir, const SyntheticShape& shape, StubGame& stub)
+{
+    fs::create_directories(dir);
+    std::mt19937   rng(shape.seed);
+    SyntheticStats total;
+    for (size_t i = 0; i < shape.files; i++)
+    {
+        auto stats = writeConfig(dir / fmt::format("customskill.bench{}.config.txt", i), i, shape, rng, stub);
+        total.files += stats.files;
+        total.nodes += stats.nodes;
+        total.links += stats.links;
+        total.ranks += stats.ranks;
+        total.invalid += stats.invalid;
+        total.bytes += stats.bytes;
+    }
+    return total;
+}
+
+const SyntheticShape* findPreset(std::string_view name)
+{
+    for (const auto& [preset_name, shape] : presets)
+        if (name == preset_name)
+            return &shape;
+    return nullptr;
+}
+
+std::vector<std::string> presetNames()
+{
+    std::vector<std::string> names;
+    for (const auto& [name, shape] : presets)
+        names.emplace_back(name);
+    return names;
+}
+
+std::optional<SyntheticShape> shapeFromArgs(const Args& args)
+{
+    SyntheticShape shape;
+    if (args.has("preset"))
+    {
+        auto preset = findPreset(args.get("preset", ""));
+        if (!preset)
+            return std::nullopt;
+        shape = *preset;
+    }
+    if (args.has("invalid"))
+        shape.setInvalid(args.get<double>("invalid", 0));
+
+    shape.files         = args.get<size_t>("files", shape.files);
+    shape.nodes         = args.get<size_t>("nodes", shape.nodes);
+    shape.links         = args.get<double>("links", shape.links);
+    shape.chain         = args.get<double>("chain", shape.chain);
+    shape.hubs          = args.get<size_t>("hubs", shape.hubs);
+    shape.fan_in        = args.get<double>("fan-in", shape.fan_in);
+    shape.backlinks     = args.get<double>("backlinks", shape.backlinks);
+    shape.max_ranks     = args.get<size_t>("ranks", shape.max_ranks);
+    shape.missing       = args.get<double>("missing", shape.missing);
+    shape.wrong_type    = args.get<double>("wrong-type", shape.wrong_type);
+    shape.disabled      = args.get<double>("disabled", shape.disabled);
+    shape.missing_first = shape.missing_first || args.has("missing-first");
+    shape.dangling      = args.get<double>("dangling", shape.dangling);
+    shape.odd_spacing   = args.get<double>("odd-spacing", shape.odd_spacing);
+    shape.positioned    = shape.positioned && !args.has("layout");
+    shape.seed          = args.get<uint32_t>("seed", shape.seed);
+    return shape;
+}
+
+void registerConfigForms(const fs::path& path, StubGame& stub)
+{
+    toml::table tbl;
+    try
+    {
+        tbl = toml::parse_file(path.string());
+    }
+    catch (const toml::parse_error&)
+    {
+        return; // the loader reports it
+    }
+
+    // forms seen before keep their type, so a perk id pointing at a global stays wrong
+    auto known = [&](const std::string& plugin, uint32_t id) {
+        return plugin.empty() || plugin == "Missing.esp" || stub.findGlobal(plugin, id, nullptr) || stub.findPerk(plugin, id, nullptr);
+    };
+
+    for (const auto& [key, val] : tbl)
+    {
+        auto key_str = std::string(key.str());
+        auto plugin  = val.value<std::string>();
+        if (!key_str.ends_with("File") || !plugin)
+            continue;
+        auto id = (uint32_t)tbl[key_str.substr(0, key_str.size() - 4) + "Id"].value_or<int64_t>(0);
+        if (!known(*plugin, id))
+            stub.addGlobal(*plugin, id);
+    }
+
+    for (const auto& [key, val] : tbl)
+    {
+        const auto* node_tbl = val.as_table();
+        if (!node_tbl || !key.str().starts_with("Node"))
+            continue;
+        auto plugin = (*node_tbl)["PerkFile"].value_or<std::string>("");
+        auto id     = (uint32_t)(*node_tbl)["PerkId"].value_or<int64_t>(0);
+        if (known(plugin, id))
+            continue;
+        auto       ranks = std::clamp<int64_t>((*node_tbl)["Ranks"].value_or<int64_t>(1), 1, 100);
+        PerkHandle prev  = nullptr;
+        for (int64_t rank = 0; rank < ranks; rank++)
+            prev = stub.addPerk(plugin, id + (uint32_t)rank, fmt::format("{} Rank {}", key.str(), rank + 1), {}, prev);
+    }
+}
+} // namespace minskill::bench
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "benchutils.h"
+#include "stubgame.h"
+
+namespace minskill::bench
+{
+namespace fs = std::filesystem;
+
+// Shape of generated customskill.*.config.txt files
+struct SyntheticShape
+{
+    size_t   files         = 16;
+    size_t   nodes         = 200;   // per file, at most 65280
+    double   links         = 2.0;   // average links per node, to later nodes nearby
+    double   chain         = 0.0;   // share of nodes also linked to the next one, for deep chains
+    size_t   hubs          = 0;     // nodes at the end of the tree that take links from all over it
+    double   fan_in        = 0.0;   // share of nodes linked to one of the hubs
+    double   backlinks     = 0.0;   // share of nodes linked to an earlier one, making cycles
+    size_t   max_ranks     = 3;     // ranks per perk are 1 to max_ranks
+    double   missing       = 0.0;   // share of nodes whose perk doesn't exist
+    bool     missing_first = false; // node 1's perk doesn't exist, so the loader drops all linked after it
+    double   wrong_type    = 0.0;   // share of nodes whose perk id is a global
+    double   disabled      = 0.0;   // share of nodes with Enable = false
+    double   dangling      = 0.0;   // share of nodes with a link to a node that doesn't exist
+    double   odd_spacing   = 0.0;   // share of Links written with stray separators & whitespace
+    bool     positioned    = true;  // false leaves all nodes to the automatic layout
+    uint32_t seed          = 1;
+
+    // Splits a share of broken nodes evenly over the four kinds
+    void setInvalid(double share);
+};
+
+struct SyntheticStats
+{
+    size_t    files   = 0;
+    size_t    nodes   = 0;
+    size_t    links   = 0;
+    size_t    ranks   = 0;
+    size_t    invalid = 0; // missing, wrong type, disabled or dangling
+    uintmax_t bytes   = 0;
+};
+
+// Writes the configs into dir and registers their globals & perks in stub.
+// The same shape and seed always give the same files.
+SyntheticStats writeSyntheticConfigs(const fs::path& dir, const SyntheticShape& shape, StubGame& stub);
+
+// Named shapes that drive SkillConfig::read into its slow paths, nullptr if there is none by that name
+const SyntheticShape*    findPreset(std::string_view name);
+std::vector<std::string> presetNames();
+
+// Registers the globals & perks a hand written config refers to, so it loads against stub.
+// Forms of Missing.esp are never registered, an optional Ranks key in a node sets its rank count.
+void registerConfigForms(const fs::path& path, StubGame& stub);
+
+// Shape from --preset and the options in shape_usage over it, nullopt for an unknown preset
+std::optional<SyntheticShape> shapeFromArgs(const Args& args);
+
+constexpr const char* shape_usage = "  --preset NAME   start from a named shape, see --presets\n"
+                                    "  --files N       config files (16)\n"
+                                    "  --nodes N       nodes per file (200)\n"
+                                    "  --links X       average links per node (2)\n"
+                                    "  --chain X       share of nodes linked to the next one (0)\n"
+                                    "  --hubs N        nodes taking links from all over the tree (0)\n"
+                                    "  --fan-in X      share of nodes linked to a hub (0)\n"
+                                    "  --backlinks X   share of nodes linked to an earlier one (0)\n"
+                                    "  --ranks N       max ranks per perk (3)\n"
+                                    "  --invalid X     share of broken nodes over the four kinds below (load_bench 0.05)\n"
+                                    "  --missing X     share of nodes with a missing perk (0)\n"
+                                    "  --missing-first node 1's perk doesn't exist\n"
+                                    "  --wrong-type X  share of nodes whose perk is a global (0)\n"
+                                    "  --disabled X    share of disabled nodes (0)\n"
+                                    "  --dangling X    share of nodes linking to no node (0)\n"
+                                    "  --odd-spacing X share of Links with stray separators (0)\n"
+                                    "  --layout        leave positions to the automatic layout\n"
+                                    "  --seed N        generator seed (1)\n";
+} // namespace minskill::bench
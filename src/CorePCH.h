@@ -0,0 +1,42 @@
+#pragma once
+
+// Precompiled header of the game independent core, which builds without CommonLibSSE
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include <imgui.h>
+
+namespace logger
+{
+using spdlog::debug;
+using spdlog::error;
+using spdlog::info;
+using spdlog::warn;
+} // namespace logger
+
+using namespace std::literals;
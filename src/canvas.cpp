@@ -0,0 +1,53 @@
+#include "canvas.h"
+
+#include "ImNodes/ImNodesEz.h"
+
+namespace minskill
+{
+CanvasPool::~CanvasPool()
+{
+    for (auto& entry : lru)
+        ImNodes::Ez::FreeContext(entry.context);
+}
+
+ImNodes::Ez::Context* CanvasPool::acquire(const std::string& key, bool* created)
+{
+    ImNodes::Ez::Context* context;
+    if (created)
+        *created = false;
+    if (auto iter = lookup.find(key); iter != lookup.end())
+    {
+        lru.splice(lru.begin(), lru, iter->second);
+        context = iter->second->context;
+    }
+    else
+    {
+        context = ImNodes::Ez::CreateContext();
+        lru.push_front({key, context});
+        lookup[key] = lru.begin();
+        evict();
+        if (created)
+            *created = true;
+    }
+    ImNodes::Ez::SetContext(context);
+    return context;
+}
+
+void CanvasPool::setCapacity(size_t cap)
+{
+    capacity = std::max<size_t>(cap, 1);
+    evict();
+}
+
+void CanvasPool::evict()
+{
+    while (lru.size() > capacity)
+    {
+        auto& entry = lru.back();
+        logger::debug("Freeing canvas of {}", entry.key);
+        ImNodes::Ez::FreeContext(entry.context);
+        lookup.erase(entry.key);
+        lru.pop_back();
+    }
+}
+} // namespace minskill
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+namespace ImNodes::Ez
+{
+struct Context;
+} // namespace ImNodes::Ez
+
+namespace minskill
+{
+// One ImNodes context per skill tree, least recently shown ones are freed past capacity
+class CanvasPool
+{
+public:
+    static CanvasPool* getSingleton()
+    {
+        static CanvasPool pool;
+        return std::addressof(pool);
+    }
+
+    ~CanvasPool();
+
+    // Makes the canvas of the given tree current, creating it if needed
+    ImNodes::Ez::Context* acquire(const std::string& key, bool* created = nullptr);
+
+    void   setCapacity(size_t cap);
+    size_t size() const { return lru.size(); }
+
+private:
+    struct Entry
+    {
+        std::string           key;
+        ImNodes::Ez::Context* context;
+    };
+
+    void evict();
+
+    size_t                                                       capacity = 8;
+    std::list<Entry>                                             lru; // front is most recent
+    std::unordered_map<std::string, std::list<Entry>::iterator> lookup;
+};
+} // namespace minskill
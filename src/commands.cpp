@@ -0,0 +1,23 @@
+#include "commands.h"
+
+namespace minskill
+{
+void CommandQueue::drain()
+{
+    auto&   configs = ConfigReader::getSingleton()->configs;
+    Command cmd;
+    while (commands.pop(cmd))
+    {
+        CommandResult result{cmd.kind, cmd.slot};
+        if (cmd.slot < configs.size())
+            result.ok = configs[cmd.slot].execute(cmd, result);
+        else
+            result.failed_reason = "Unknown skill!";
+        for (const auto& change : cmd.changes)
+            result.touched.push_back(change.num);
+
+        if (!results.push(std::move(result)))
+            logger::warn("Command result dropped, the menu is not reading them.");
+    }
+}
+} // namespace minskill
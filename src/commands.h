@@ -0,0 +1,63 @@
+#pragma once
+
+#include "file.h"
+
+#include <atomic>
+
+namespace minskill
+{
+// Bounded single-producer single-consumer ring, one slot is kept empty
+template <class T, size_t N>
+class SpscQueue
+{
+public:
+    bool push(T&& item)
+    {
+        auto tail = write_pos.load(std::memory_order_relaxed);
+        auto next = (tail + 1) % N;
+        if (next == read_pos.load(std::memory_order_acquire))
+            return false;
+        items[tail] = std::move(item);
+        write_pos.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        auto head = read_pos.load(std::memory_order_relaxed);
+        if (head == write_pos.load(std::memory_order_acquire))
+            return false;
+        item = std::move(items[head]);
+        read_pos.store((head + 1) % N, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::array<T, N>                items;
+    alignas(64) std::atomic<size_t> read_pos  = 0;
+    alignas(64) std::atomic<size_t> write_pos = 0;
+};
+
+// Menu actions that change game state, applied by UpdateHook on the game thread.
+// Results come back the other way and are picked up at the start of the next draw.
+class CommandQueue
+{
+public:
+    static CommandQueue* getSingleton()
+    {
+        static CommandQueue queue;
+        return std::addressof(queue);
+    }
+
+    // UI thread, false if the queue is full
+    bool send(Command&& cmd) { return commands.push(std::move(cmd)); }
+    // UI thread
+    bool receive(CommandResult& result) { return results.pop(result); }
+    // game thread
+    void drain();
+
+private:
+    SpscQueue<Command, 64>       commands;
+    SpscQueue<CommandResult, 64> results;
+};
+} // namespace minskill
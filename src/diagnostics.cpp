@@ -0,0 +1,86 @@
+#include "diagnostics.h"
+
+namespace minskill
+{
+constexpr size_t max_samples = 4;
+
+std::string_view describe(DiagKind kind)
+{
+    switch (kind)
+    {
+        case DiagKind::MissingForm: return "form not found, node disabled if a perk";
+        case DiagKind::WrongFormType: return "form of wrong type";
+        case DiagKind::DependentDisabled: return "node disabled with its prerequisite";
+    }
+    return "unknown";
+}
+
+void Diagnostics::report(DiagKind kind, std::string_view plugin, uint32_t id)
+{
+    auto& group = groups[{std::string(plugin), kind}];
+    if (group.count++ == 0)
+    {
+        group.plugin = plugin;
+        group.kind   = kind;
+    }
+    if (group.samples.size() < max_samples)
+        group.samples.push_back(id);
+}
+
+size_t Diagnostics::total() const
+{
+    size_t cts = 0;
+    for (const auto& [key, group] : groups)
+        cts += group.count;
+    return cts;
+}
+
+static std::string formatSamples(const DiagGroup& group)
+{
+    std::string result;
+    for (auto id : group.samples)
+        result += group.kind == DiagKind::DependentDisabled ? fmt::format(" Node{}", id) : fmt::format(" {:x}", id);
+    if (group.count > group.samples.size())
+        result += " ...";
+    return result;
+}
+
+void Diagnostics::logSummary(std::string_view config_name) const
+{
+    if (groups.empty())
+        return;
+
+    std::string msg = fmt::format("{} problems while loading {}:", total(), config_name);
+    for (const auto& [key, group] : groups)
+        msg += fmt::format("\n\t{} x {} [{}]:{}", group.count, describe(group.kind), group.plugin.empty() ? "-" : group.plugin, formatSamples(group));
+    logger::warn("{}", msg);
+}
+
+void Diagnostics::draw() const
+{
+    if (groups.empty() || !ImGui::TreeNode("LoadProblems", "Load problems (%zu)", total()))
+        return;
+
+    if (ImGui::BeginTable("Problems", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter))
+    {
+        ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthStretch, 1);
+        ImGui::TableSetupColumn("Problem", ImGuiTableColumnFlags_WidthStretch, 4);
+        ImGui::TableSetupColumn("Plugin", ImGuiTableColumnFlags_WidthStretch, 3);
+        ImGui::TableSetupColumn("Examples", ImGuiTableColumnFlags_WidthStretch, 3);
+        ImGui::TableHeadersRow();
+        for (const auto& [key, group] : groups)
+        {
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", group.count);
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(describe(group.kind).data());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(group.plugin.empty() ? "-" : group.plugin.c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(formatSamples(group).c_str());
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TreePop();
+}
+} // namespace minskill
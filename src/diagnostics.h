@@ -0,0 +1,39 @@
+#pragma once
+
+namespace minskill
+{
+enum class DiagKind : uint8_t
+{
+    MissingForm,
+    WrongFormType,
+    DependentDisabled // node removed with its missing prerequisite
+};
+
+std::string_view describe(DiagKind kind);
+
+struct DiagGroup
+{
+    std::string             plugin;
+    DiagKind                kind;
+    uint32_t                count = 0;
+    std::vector<uint32_t>   samples; // first few ids, node numbers for dependents
+};
+
+// Load problems of one config, grouped by (plugin, kind) instead of logged one by one
+class Diagnostics
+{
+public:
+    void report(DiagKind kind, std::string_view plugin, uint32_t id);
+    void clear() { groups.clear(); }
+
+    // One log entry for all problems of the config
+    void logSummary(std::string_view config_name) const;
+    void draw() const;
+
+    bool   empty() const { return groups.empty(); }
+    size_t total() const;
+
+private:
+    std::map<std::pair<std::string, DiagKind>, DiagGroup> groups;
+};
+} // namespace minskill
@@ -1,7 +1,15 @@
 #include "file.h"
+#include "canvas.h"
+#include "commands.h"
+#include "layout.h"
+#include "manifest.h"
+#include "perfstats.h"
+#include "replay.h"
+#include "trace.h"
 #include "utils.h"
+#include "viewstore.h"
 
-#include <regex>
+#include <charconv>
 #include <sstream>
 #include "toml++/toml.h"
 
@@ -9,128 +17,169 @@
 
 namespace minskill
 {
-const fs::path config_dir    = "data/NetScriptFramework/Plugins";
-const auto     config_prefix = "customskill."sv;
-const auto     config_suffix = ".config.txt"sv;
+const fs::path config_dir = "data/NetScriptFramework/Plugins";
 
-const ImVec2 scale         = {70, 400};
-auto         none_color    = IM_COL32(150, 150, 150, 255); // not obtained perk color
-auto         partial_color = IM_COL32(255, 102, 25, 255);  // partly obtained perk color
-auto         full_color    = IM_COL32(0, 230, 153, 255);   // fully obtained perk color
-auto         error_color   = IM_COL32(255, 20, 20, 255);   // error text color
+const ImVec2 scale            = {70, 400};
+const double summary_interval = 0.5; // seconds between skill list refreshes
+const auto   trace_window     = 5000ms;
+auto         none_color       = IM_COL32(150, 150, 150, 255); // not obtained perk color
+auto         avail_color      = IM_COL32(255, 235, 90, 255);  // purchasable perk color
+auto         partial_color    = IM_COL32(255, 102, 25, 255);  // partly obtained perk color
+auto         full_color       = IM_COL32(0, 230, 153, 255);   // fully obtained perk color
+auto         error_color      = IM_COL32(255, 20, 20, 255);   // error text color
+auto         prereq_color     = IM_COL32(255, 200, 50, 255);  // highlighted prerequisite border & link color
+auto         depend_color     = IM_COL32(80, 170, 255, 255);  // highlighted dependent border & link color
+auto         plan_color       = IM_COL32(200, 120, 255, 255); // planned path border & link color
 
 struct TempPerk
 {
-    std::vector<uint16_t> links;
-
-    bool         enabled = false;
-    RE::BGSPerk* perk;
-    int          gridx = 0, gridy = 0;
-    float        x = 0, y = 0;
-
-    std::string plugin;
-    RE::FormID  id;
+    const ParsedNode* node    = nullptr;
+    bool              enabled = true;
+    PerkHandle        perk    = nullptr;
 };
 
-void SkillConfig::read(const fs::path& path)
+std::optional<ParsedConfig> parseConfig(const fs::path& path)
 {
-    this->path = path;
-    if (!fs::is_regular_file(path))
-    {
-        logger::error("File {} does not exist. This shouldn't happen. Please report to author!", path.string());
-        return;
-    }
-
+    TraceZone   zone("parse");
     toml::table tbl;
     try
     {
         tbl = toml::parse_file(path.string());
     }
-    catch (toml::parse_error err)
+    catch (const toml::parse_error& err)
     {
         std::ostringstream strstrm;
         strstrm << err;
         logger::error("Failed to parse file {}.\n\tError: {}", path.string(), strstrm.str());
+        return std::nullopt;
+    }
+
+    auto form_ref = [&](std::string_view key) {
+        return FormRef{tbl[fmt::format("{}File", key)].value_or<std::string>(""), (uint32_t)tbl[fmt::format("{}Id", key)].value_or<int64_t>(0)};
+    };
+
+    ParsedConfig parsed;
+    parsed.name        = tbl["Name"].value_or<std::string>(path.filename().string());
+    parsed.desc        = tbl["Description"].value_or<std::string>("");
+    parsed.skill_lvl   = form_ref("Level");
+    parsed.lvl_ratio   = form_ref("Ratio");
+    parsed.show_lvl_up = form_ref("ShowLevelup");
+    parsed.perk_pts    = form_ref("PerkPoints");
+    parsed.legend_cts  = form_ref("Legendary");
+
+    // keys are iterated by name, so the same number written twice keeps the later key
+    std::map<uint16_t, ParsedNode> nodes;
+    for (const auto& [key, val] : tbl)
+    {
+        // Node followed by a number that fits uint16_t and nothing else
+        auto key_str = key.str();
+        if (!key_str.starts_with("Node"))
+            continue;
+        uint32_t num      = 0;
+        auto     num_str  = key_str.substr(4);
+        auto [end, error] = std::from_chars(num_str.data(), num_str.data() + num_str.size(), num);
+        if (num_str.empty() || error != std::errc() || end != num_str.data() + num_str.size() || num == 0 || num > UINT16_MAX)
+            continue;
+        const auto* node_ptr = val.as_table();
+        if (!node_ptr)
+            continue;
+        const auto& node_tbl = *node_ptr;
+
+        if (!node_tbl["Enable"].value_or<bool>(false))
+            continue;
+
+        ParsedNode node;
+        node.num         = (uint16_t)num;
+        node.perk.plugin = node_tbl["PerkFile"].value_or<std::string>("");
+        node.perk.id     = (uint32_t)node_tbl["PerkId"].value_or<int64_t>(0);
+        node.x           = node_tbl["X"].value_or<float>(0);
+        node.y           = node_tbl["Y"].value_or<float>(0);
+        node.gridx       = (int)node_tbl["GridX"].value_or<int64_t>(0);
+        node.gridy       = (int)node_tbl["GridY"].value_or<int64_t>(0);
+        node.has_pos     = node_tbl.contains("X") || node_tbl.contains("Y") || node_tbl.contains("GridX") || node_tbl.contains("GridY");
+        parseStrList(node.links, node_tbl["Links"].value_or<std::string>(""));
+
+        nodes[node.num] = std::move(node);
+    }
+
+    parsed.nodes.reserve(nodes.size());
+    for (auto& [num, node] : nodes)
+        parsed.nodes.push_back(std::move(node));
+    return parsed;
+}
+
+void SkillConfig::read(const fs::path& path)
+{
+    TraceZone zone("SkillConfig::read");
+    this->path = path;
+    diagnostics.clear();
+    if (!fs::is_regular_file(path))
+    {
+        logger::error("File {} does not exist. This shouldn't happen. Please report to author!", path.string());
         return;
     }
 
-    name = tbl["Name"].as_string()->get();
-    desc = tbl["Description"].as_string()->get();
+    if (auto parsed = parseConfig(path))
+        resolve(path, *parsed);
+}
 
-    g_skill_lvl = getForm<RE::TESGlobal>(tbl["LevelFile"].value_or<std::string>(""), (RE::FormID)tbl["LevelId"].value_or<int64_t>(0));
+void SkillConfig::resolve(const fs::path& path, const ParsedConfig& parsed, LayoutCache* layout_cache)
+{
+    TraceZone zone("SkillConfig::resolve");
+    this->path = path;
+    diagnostics.clear();
+    name = parsed.name;
+    desc = parsed.desc;
+
+    TraceZone lookup_zone("form lookup");
+    g_skill_lvl = game().findGlobal(parsed.skill_lvl.plugin, parsed.skill_lvl.id, &diagnostics);
     if (!g_skill_lvl)
     {
         logger::error("Cannot find value of LevelFile or LevelId");
         return;
     }
-    g_lvl_ratio = getForm<RE::TESGlobal>(tbl["RatioFile"].value_or<std::string>(""), (RE::FormID)tbl["RatioId"].value_or<int64_t>(0));
+    g_lvl_ratio = game().findGlobal(parsed.lvl_ratio.plugin, parsed.lvl_ratio.id, &diagnostics);
     if (!g_lvl_ratio)
     {
         logger::error("Cannot find value of RatioFile or RatioId");
         return;
     }
-    g_show_lvl_up = getForm<RE::TESGlobal>(tbl["ShowLevelupFile"].value_or<std::string>(""), (RE::FormID)tbl["ShowLevelupId"].value_or<int64_t>(0));
+    g_show_lvl_up = game().findGlobal(parsed.show_lvl_up.plugin, parsed.show_lvl_up.id, &diagnostics);
     if (!g_show_lvl_up)
     {
         logger::error("Cannot find value of ShowLevelupFile or ShowLevelupId");
         return;
     }
-    g_perk_pts   = getForm<RE::TESGlobal>(tbl["PerkPointsFile"].value_or<std::string>(""), (RE::FormID)tbl["PerkPointsId"].value_or<int64_t>(0));
-    g_legend_cts = getForm<RE::TESGlobal>(tbl["LegendaryFile"].value_or<std::string>(""), (RE::FormID)tbl["LegendaryId"].value_or<int64_t>(0));
-
-    // Read perks
-    std::map<uint16_t, TempPerk> temp_perks;
-    for (const auto& [key, val] : tbl)
-    {
-        std::string key_str(key.str());
-        std::smatch m;
-        std::regex  node_regex("^Node([0-9]+)");
-        if (std::regex_match(key_str, m, node_regex))
-        {
-            uint16_t num = std::stoi(m[1].str());
-            if (num == 0) continue;
-            auto node_tbl = *val.as_table();
-
-            TempPerk temp;
-
-            temp.enabled = node_tbl["Enable"].value_or<bool>(false);
-            if (!temp.enabled) continue;
-
-            temp.plugin = node_tbl["PerkFile"].value_or<std::string>("");
-            temp.id     = node_tbl["PerkId"].value_or<int64_t>(0);
-            temp.x      = node_tbl["X"].value_or<double>(0);
-            temp.y      = node_tbl["Y"].value_or<double>(0);
-            temp.gridx  = node_tbl["GridX"].value_or<int64_t>(0);
-            temp.gridy  = node_tbl["GridY"].value_or<int64_t>(0);
-            parseStrList(temp.links, node_tbl["Links"].value_or<std::string>(""));
-
-            temp_perks[num] = temp;
-        }
-    }
+    // optional, only a global the config names but the game lacks is a problem
+    auto optional_global = [this](const FormRef& form) {
+        return form.plugin.empty() ? nullptr : game().findGlobal(form.plugin, form.id, &diagnostics);
+    };
+    g_perk_pts   = optional_global(parsed.perk_pts);
+    g_legend_cts = optional_global(parsed.legend_cts);
 
     // Find perk form & skill req
-    std::list<uint16_t> disabled_nodes;
-    for (auto& [num, perk] : temp_perks)
+    std::map<uint16_t, TempPerk> temp_perks;
+    std::list<uint16_t>          disabled_nodes;
+    for (const auto& node : parsed.nodes)
     {
-        if (perk.enabled)
+        auto& perk = temp_perks[node.num];
+        perk.node  = &node;
+        perk.perk  = game().findPerk(node.perk.plugin, node.perk.id, &diagnostics);
+        if (!perk.perk)
         {
-            perk.perk = getForm<RE::BGSPerk>(perk.plugin, perk.id);
-            if (!perk.perk)
-            {
-                logger::warn("Cannot find perk {:x} in {}. Perk disabled.", perk.id, perk.plugin.data());
-                perk.enabled = false;
-            }
+            perk.enabled = false;
+            disabled_nodes.push_back(node.num);
         }
-        if (!perk.enabled)
-            disabled_nodes.push_back(num);
     }
     // Propagate disabled perks
+    // links to nodes that don't exist are skipped rather than added as disabled entries
     for (auto disabled_iter = disabled_nodes.begin(); disabled_iter != disabled_nodes.end(); disabled_iter++)
-        for (auto linked_num : temp_perks[*disabled_iter].links)
-            if (temp_perks[linked_num].enabled)
+        for (auto linked_num : temp_perks.at(*disabled_iter).node->links)
+            if (auto linked = temp_perks.find(linked_num); linked != temp_perks.end() && linked->second.enabled)
             {
-                temp_perks[linked_num].enabled = false;
+                linked->second.enabled = false;
                 disabled_nodes.push_back(linked_num);
+                diagnostics.report(DiagKind::DependentDisabled, "", linked_num);
             }
 
     // Fill in actual perks
@@ -139,103 +188,494 @@ void SkillConfig::read(const fs::path& path)
     {
         if (temp_perk.enabled)
         {
-            auto& curr_perk = perks[num] = Perk();
+            const auto& node      = *temp_perk.node;
+            auto&       curr_perk = perks[num] = Perk();
 
-            curr_perk.perk  = temp_perk.perk;
-            curr_perk.pos.y = temp_perk.gridx * scale.x + temp_perk.x * scale.x;
-            curr_perk.pos.x = temp_perk.gridy * scale.y + temp_perk.y * scale.y;
-            for (const auto& link : temp_perk.links)
-                if (temp_perks[link].enabled)
+            curr_perk.perk        = temp_perk.perk;
+            curr_perk.pos.y       = node.gridx * scale.x + node.x * scale.x;
+            curr_perk.pos.x       = node.gridy * scale.y + node.y * scale.y;
+            curr_perk.default_pos = curr_perk.pos;
+            for (const auto& link : node.links)
+                if (auto linked = temp_perks.find(link); linked != temp_perks.end() && linked->second.enabled)
                     curr_perk.links.push_back(link);
-            auto newest_perk = curr_perk.perk;
-            while (newest_perk)
+            readRanks(curr_perk);
+        }
+    }
+
+    lookup_zone.stop();
+
+    // Build graph & lay out nodes without coordinates
+    TraceZone graph_zone("graph build");
+    std::map<uint16_t, std::vector<uint16_t>> links;
+    bool                                      need_layout = false;
+    for (const auto& [num, perk_info] : perks)
+    {
+        links[num] = perk_info.links;
+        need_layout |= !temp_perks.at(num).node->has_pos;
+    }
+    graph.build(links);
+    for (auto& [num, perk_info] : perks)
+        perk_info.idx = *graph.indexOf(num);
+    if (need_layout)
+    {
+        // laid out nodes start one column right of the positioned ones, so the two never overlap
+        auto right = std::numeric_limits<float>::lowest(), top = std::numeric_limits<float>::max();
+        for (const auto& [num, perk_info] : perks)
+            if (temp_perks.at(num).node->has_pos)
             {
-                newest_perk = newest_perk->nextPerk;
-                curr_perk.vers++;
+                right = std::max(right, perk_info.pos.x);
+                top   = std::min(top, perk_info.pos.y);
+            }
+        auto origin = right == std::numeric_limits<float>::lowest() ? ImVec2(0, 0) : ImVec2(right + scale.y, top);
+
+        LayoutCache local_cache;
+        const auto& layout = (layout_cache ? *layout_cache : local_cache).get(links);
+        for (auto& [num, perk_info] : perks)
+            if (!temp_perks.at(num).node->has_pos)
+            {
+                const auto& grid_pos  = layout.at(num);
+                perk_info.pos         = {origin.x + grid_pos.x * scale.y, origin.y + grid_pos.y * scale.x};
+                perk_info.default_pos = perk_info.pos;
             }
-        }
     }
 
     loaded = true;
 }
 
+void SkillConfig::readRanks(Perk& perk_info)
+{
+    perk_info.ranks.clear();
+    for (auto rank_perk = perk_info.perk; rank_perk; rank_perk = game().nextRank(rank_perk))
+    {
+        auto reqs = game().requirements(rank_perk, g_skill_lvl, g_legend_cts);
+        perk_info.ranks.push_back({rank_perk, reqs.skill_req, reqs.legend_req, reqs.other_conds, game().perkName(rank_perk), game().perkDescription(rank_perk)});
+    }
+    perk_info.vers = (uint8_t)perk_info.ranks.size();
+}
+
+long SkillConfig::getLivePerkPoints() const
+{
+    return g_perk_pts ? std::lround(game().getGlobal(g_perk_pts)) : game().perkPoints();
+}
+
+void SkillConfig::setLivePerkPoints(long points)
+{
+    points = std::max(points, 0L);
+    if (g_perk_pts)
+        game().setGlobal(g_perk_pts, (float)points);
+    else
+        game().setPerkPoints(points);
+}
+
+long SkillConfig::getPerkPoints() const
+{
+    if (sim)
+        return sim->perk_pts;
+    return std::lround(ConfigReader::getSingleton()->globals.get(slot, GlobalField::PerkPoints));
+}
+
+long SkillConfig::getSkillLevel() const
+{
+    if (sim)
+        return sim->skill_lvl;
+    return std::lround(ConfigReader::getSingleton()->globals.get(slot, GlobalField::SkillLevel));
+}
+
+long SkillConfig::getLegendCount() const
+{
+    if (sim)
+        return sim->legend_cts;
+    return std::lround(ConfigReader::getSingleton()->globals.get(slot, GlobalField::LegendCount));
+}
+
+uint8_t SkillConfig::getOwned(const Perk& perk_info) const
+{
+    if (sim)
+        if (auto iter = sim->owned.find(graph.num(perk_info.idx)); iter != sim->owned.end())
+            return iter->second;
+    return perk_info.owned;
+}
+
+bool SkillConfig::isEligible(const Perk& perk_info) const
+{
+    auto owned = getOwned(perk_info);
+    if (owned >= perk_info.vers)
+        return false;
+
+    // any one owned prerequisite opens the node
+    const auto& parents = graph.parents(perk_info.idx);
+    if (!parents.empty() && std::none_of(parents.begin(), parents.end(), [this](uint16_t parent) { return getOwned(perks.at(graph.num(parent))) > 0; }))
+        return false;
+
+    const auto& rank = perk_info.ranks[owned];
+    if (rank.skill_req > frontier_state.skill_lvl || rank.legend_req > frontier_state.legend_cts)
+        return false;
+    // other conditions can only be checked against the live player
+    return !rank.other_conds || sim || game().conditionsMet(rank.perk);
+}
+
+static uint8_t countOwned(const Perk& perk_info)
+{
+    uint8_t owned = 0;
+    while (owned < perk_info.vers && game().hasPerk(perk_info.ranks[owned].perk))
+        owned++;
+    return owned;
+}
+
+// Full rescan, for when perks may have changed outside of this menu
+void SkillConfig::syncOwned()
+{
+    for (auto& [num, perk_info] : perks)
+        perk_info.owned = countOwned(perk_info);
+    updateFrontier(true);
+    plan_dirty = true;
+}
+
+void SkillConfig::onRankChanged(uint16_t num)
+{
+    auto& perk_info = perks.at(num);
+    if (!sim)
+        perk_info.owned = countOwned(perk_info);
+
+    // only the node itself and the nodes it unlocks can change
+    perk_info.eligible = isEligible(perk_info);
+    plan_dirty         = true;
+    view_dirty         = true;
+    for (auto child : graph.children(perk_info.idx))
+    {
+        auto& child_info    = perks.at(graph.num(child));
+        child_info.eligible = isEligible(child_info);
+    }
+}
+
+void SkillConfig::updateFrontier(bool force)
+{
+    FrontierState curr_state = {getSkillLevel(), getLegendCount()};
+    if (!force && curr_state == frontier_state)
+        return;
+
+    frontier_state = curr_state;
+    view_dirty     = true;
+    for (auto& [num, perk_info] : perks)
+        perk_info.eligible = isEligible(perk_info);
+}
+
+ViewInput SkillConfig::makeViewInput(long perk_pts)
+{
+    ViewInput input{++view_gen, slot, {none_color, partial_color, full_color, avail_color}, perk_pts};
+    input.perks.resize(graph.size());
+    input.owned.resize(graph.size());
+    input.eligible.resize(graph.size());
+    for (const auto& [num, perk_info] : perks)
+    {
+        input.perks[perk_info.idx]    = &perk_info;
+        input.owned[perk_info.idx]    = getOwned(perk_info);
+        input.eligible[perk_info.idx] = perk_info.eligible;
+    }
+    return input;
+}
+
+void SkillConfig::beginSimulation()
+{
+    auto perk_pts   = getPerkPoints();
+    auto legend_cts = getLegendCount();
+    sim             = Simulation{{}, perk_pts, getSkillLevel(), legend_cts, perk_pts, legend_cts};
+    updateFrontier(true);
+    plan_dirty = true;
+}
+
+void SkillConfig::discardSimulation()
+{
+    sim.reset();
+    updateFrontier(true);
+    plan_dirty = true;
+}
+
+bool SkillConfig::commitSimulation(std::string_view& failed_reason)
+{
+    if (!sim)
+        return true;
+
+    // Globals go as changes from the simulation's start, so points gained meanwhile are kept.
+    // The simulated level is only for trying out requirements and is never written.
+    Command cmd{CommandKind::Commit};
+    for (const auto& [num, sim_owned] : sim->owned)
+        if (auto delta = (int)sim_owned - (int)perks.at(num).owned; delta != 0)
+            cmd.changes.push_back({num, delta});
+    // prerequisites first, so their perks are in place when dependents check conditions
+    std::sort(cmd.changes.begin(), cmd.changes.end(), [this](const RankChange& a, const RankChange& b) {
+        return graph.topoPos(perks.at(a.num).idx) < graph.topoPos(perks.at(b.num).idx);
+    });
+    cmd.check_points = false;
+    cmd.perk_pts     = sim->perk_pts - sim->base_perk_pts;
+    cmd.legend_cts   = sim->legend_cts - sim->base_legend_cts;
+    if (!send(std::move(cmd), failed_reason))
+        return false;
+
+    committing = std::move(sim);
+    sim.reset();
+    updateFrontier(true);
+    plan_dirty = true;
+    return true;
+}
+
 void SkillConfig::draw()
 {
+    TraceZone zone("SkillConfig::draw");
 
     if (!loaded)
     {
         ImGui::Text("Failed to load config {}.\n\tPlease check log at [My Games/Skyrim Special Edition/SKSE/MinimalisticSkillMenu.log].", path.c_str());
+        diagnostics.draw();
         return;
     }
+    diagnostics.draw();
 
-    auto player = RE::PlayerCharacter::GetSingleton();
+    // reopening the menu or switching tabs may come after changes made elsewhere
+    if (last_draw_frame != ImGui::GetFrameCount() - 1)
+        syncOwned();
+    else
+        updateFrontier();
+    last_draw_frame = ImGui::GetFrameCount();
+
+    if (sim)
+    {
+        ImGui::PushStyleColor(ImGuiCol_Text, avail_color);
+        ImGui::Text("SIMULATION - changes are not applied to the game until committed.");
+        ImGui::PopStyleColor();
+        static bool             commit_failed = false;
+        static std::string_view failed_reason = "";
+        if (ImGui::Button("Commit"))
+            commit_failed = !commitSimulation(failed_reason);
+        ImGui::SameLine();
+        if (ImGui::Button("Discard"))
+        {
+            discardSimulation();
+            commit_failed = false;
+        }
+        if (commit_failed)
+        {
+            ImGui::SameLine();
+            ImGui::PushStyleColor(ImGuiCol_Text, error_color);
+            ImGui::Text(failed_reason.data());
+            ImGui::PopStyleColor();
+        }
+    }
+    else if (ImGui::Button("Simulate"))
+        beginSimulation();
 
-    ImGui::Text(fmt::format("{}  lvl. {}", name, std::lround(g_skill_lvl->value)).c_str());
-    ImGui::ProgressBar(g_lvl_ratio->value, ImVec2(-1.0f, 0.0f));
+    if (sim)
+    {
+        int sim_lvl = (int)sim->skill_lvl, sim_pts = (int)sim->perk_pts, sim_legend = (int)sim->legend_cts;
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+        if (ImGui::InputInt("Level", &sim_lvl))
+            sim->skill_lvl = std::max(sim_lvl, 0);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+        if (ImGui::InputInt("Points", &sim_pts))
+            sim->perk_pts = std::max(sim_pts, 0);
+        if (g_legend_cts)
+        {
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+            if (ImGui::InputInt("Legendary", &sim_legend))
+                sim->legend_cts = std::max(sim_legend, 0);
+        }
+        updateFrontier();
+    }
+    else
+        ImGui::Text(fmt::format("{}  lvl. {}", name, getSkillLevel()).c_str());
+    ImGui::ProgressBar(ConfigReader::getSingleton()->globals.get(slot, GlobalField::LevelRatio), ImVec2(-1.0f, 0.0f));
     if (g_legend_cts)
     {
-        long                    legend_cts        = std::lround(g_legend_cts->value);
-        static bool             failed_legend     = false;
-        static std::string_view cannot_legend_str = "Not enough skill level!";
-        if (std::lround(g_skill_lvl->value) >= 100)
+        long legend_cts = getLegendCount();
+        if (getSkillLevel() >= 100)
             if (ImGui::Button("Set Legendary"))
                 setLegendary();
         ImGui::SameLine();
         ImGui::Text(fmt::format("Legnedary Count: {}", legend_cts).c_str());
     }
-    ImGui::Text(fmt::format("Perk Points: {}", g_perk_pts ? (int8_t)g_perk_pts->value : RE::PlayerCharacter::GetSingleton()->GetGameStatsData().perkCount).c_str());
+    auto perk_pts = getPerkPoints();
+    ImGui::Text(fmt::format("Perk Points: {}", perk_pts).c_str());
+    if (cmd_failed)
+    {
+        ImGui::SameLine();
+        ImGui::PushStyleColor(ImGuiCol_Text, error_color);
+        ImGui::Text(cmd_failed->data());
+        ImGui::PopStyleColor();
+    }
+
+    // node contents are built off the draw callback, only the first view is built here
+    if (view_pts != (perk_pts > 0))
+    {
+        view_pts   = perk_pts > 0;
+        view_dirty = true;
+    }
+    if (view_dirty)
+    {
+        view_dirty = false;
+        if (view.nodes.size() != graph.size())
+            buildTreeView(makeViewInput(perk_pts), view);
+        else
+            ViewModelBuilder::getSingleton()->request(makeViewInput(perk_pts));
+    }
+    ViewModelBuilder::getSingleton()->fetch(slot, view);
+    ImGui::SameLine();
+    ImGui::Checkbox("Plan Mode", &plan_mode);
+
+    if (plan_mode)
+    {
+        std::optional<uint16_t> target;
+        for (const auto& [num, perk_info] : perks)
+            if (perk_info.selected)
+            {
+                target = num;
+                break;
+            }
+        if (!target)
+            plan.reset();
+        else if (plan_dirty || !plan || plan->target != *target)
+            plan = makePlan(*target);
+        plan_dirty = false;
+    }
+    const PerkPlan* shown_plan = plan_mode && plan && plan->reachable ? &*plan : nullptr;
 
     // Skill tree
     if (ImGui::Begin(fmt::format("Perk Tree ({})", name).c_str(), nullptr, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse))
     {
-        static float zoom = 1.0f;
-        ImGui::SliderFloat("Zoom", &zoom, 0.2f, 2.f, "%.1fx");
+        bool created = false;
+        CanvasPool::getSingleton()->acquire(path.string(), &created);
+        auto canvas = &ImNodes::Ez::GetState();
+        if (created)
+            restoreView(*canvas);
+        bool view_changed = ImGui::SliderFloat("Zoom", &canvas->Zoom, 0.2f, 2.f, "%.1fx");
 
         ImNodes::Ez::BeginCanvas();
 
-        ImNodes::GetCurrentCanvas()->Zoom = zoom;
-
-        for (auto& [num, perk_info] : perks)
+        if (focus_node)
         {
-            auto    newest_perk = perk_info.perk;
-            uint8_t curr_ver    = 0;
-            while (player->HasPerk(newest_perk) && newest_perk->nextPerk)
+            if (auto iter = perks.find(*focus_node); iter != perks.end())
             {
-                curr_ver++;
-                newest_perk = newest_perk->nextPerk;
+                auto win_size  = ImGui::GetWindowSize();
+                canvas->Offset = {win_size.x * 0.5f - iter->second.pos.x * canvas->Zoom, win_size.y * 0.5f - iter->second.pos.y * canvas->Zoom};
             }
-            curr_ver += player->HasPerk(newest_perk);
+            focus_node.reset();
+        }
+
+        // Hovered perk takes precedence over the selected one
+        auto highlight = hovered_idx;
+        hovered_idx.reset();
+        if (!highlight)
+            for (const auto& [num, perk_info] : perks)
+                if (perk_info.selected)
+                {
+                    highlight = perk_info.idx;
+                    break;
+                }
+
+        PerfScope canvas_scope(PerfZone::Canvas);
+        TraceZone canvas_zone("canvas nodes");
+        for (auto& [num, perk_info] : perks)
+        {
+            const auto& node_view = view.nodes[perk_info.idx];
 
             ImNodes::Ez::SlotInfo input  = {"req", 1};
             ImNodes::Ez::SlotInfo output = {"", 1};
 
-            auto color  = curr_ver ? (curr_ver == perk_info.vers ? full_color : partial_color) : none_color;
+            auto relation      = highlight ? graph.relation(*highlight, perk_info.idx) : PerkGraph::Relation::None;
+            int  border_pushed = 0;
+            if (shown_plan)
+            {
+                if (shown_plan->on_path[perk_info.idx])
+                {
+                    ImNodes::Ez::PushStyleColor(ImNodesStyleCol_NodeBorder, plan_color);
+                    border_pushed = 1;
+                }
+            }
+            else if (relation == PerkGraph::Relation::Ancestor || relation == PerkGraph::Relation::Descendant)
+            {
+                ImNodes::Ez::PushStyleColor(ImNodesStyleCol_NodeBorder, relation == PerkGraph::Relation::Ancestor ? prereq_color : depend_color);
+                border_pushed = 1;
+            }
+
             bool popped = false;
-            ImGui::PushStyleColor(ImGuiCol_Text, color);
-            if (ImNodes::Ez::BeginNode(&perk_info, newest_perk->GetName(), &perk_info.pos, &perk_info.selected))
+            ImGui::PushStyleColor(ImGuiCol_Text, node_view.color);
+            if (ImNodes::Ez::BeginNode(&perk_info, node_view.label, &perk_info.pos, &perk_info.selected))
             {
                 ImGui::PopStyleColor();
                 popped = true;
 
+                if (ImNodes::IsNodeHovered())
+                    hovered_idx = perk_info.idx;
+
                 ImNodes::Ez::InputSlots(&input, 1);
-                ImGui::Text(fmt::format("({}/{})", curr_ver, perk_info.vers).c_str());
+                ImGui::TextUnformatted(node_view.rank_text.c_str());
                 ImNodes::Ez::OutputSlots(&output, 1);
                 ImNodes::Ez::EndNode();
             }
             if (!popped)
                 ImGui::PopStyleColor();
+            ImNodes::Ez::PopStyleColor(border_pushed);
         }
+        canvas_scope.stop();
+        canvas_zone.stop();
 
+        PerfScope connections_scope(PerfZone::Connections);
+        TraceZone connections_zone("canvas connections");
+        size_t    curve_cts = 0;
         for (auto& [num, perk_info] : perks)
             for (auto link_num : perk_info.links)
-                ImNodes::Connection(&perks[link_num], "req", &perk_info, "");
+            {
+                auto& linked_perk = perks[link_num];
+                curve_cts++;
 
-        ImNodes::Ez::EndCanvas();
+                ImU32 path_color = 0;
+                if (shown_plan)
+                {
+                    if (shown_plan->on_path[perk_info.idx] && shown_plan->on_path[linked_perk.idx])
+                        path_color = plan_color;
+                }
+                else if (highlight)
+                {
+                    auto src = *highlight;
+                    if (graph.isAncestor(perk_info.idx, src) && (linked_perk.idx == src || graph.isAncestor(linked_perk.idx, src)))
+                        path_color = prereq_color;
+                    else if (graph.isDescendant(linked_perk.idx, src) && (perk_info.idx == src || graph.isDescendant(perk_info.idx, src)))
+                        path_color = depend_color;
+                }
+
+                if (path_color)
+                    ImNodes::Ez::PushStyleColor(ImNodesStyleCol_Connection, path_color);
+                ImNodes::Connection(&linked_perk, "req", &perk_info, "");
+                if (path_color)
+                    ImNodes::Ez::PopStyleColor(1);
+            }
+        connections_scope.stop();
+        connections_zone.stop();
+
+        // pan, zoom and drag all end with a release or a wheel tick
+        const auto& io = ImGui::GetIO();
+        if (view_changed || ImGui::IsMouseReleased(0) || ImGui::IsMouseReleased(2) || io.MouseWheel != 0 || io.MouseWheelH != 0)
+            saveView(*canvas);
+
+        {
+            TraceZone end_zone("EndCanvas");
+            ImNodes::Ez::EndCanvas();
+        }
+
+        if (auto stats = PerfStats::getSingleton(); stats->enabled())
+            stats->setCounts(perks.size(), curve_cts, ImGui::GetWindowDrawList()->VtxBuffer.Size);
 
         ImGui::End();
     }
 
     ImGui::Separator();
+    if (plan_mode)
+    {
+        drawPlan();
+        return;
+    }
+
     // Perk Info
     bool has_selected = false;
     for (auto& [num, perk_info] : perks)
@@ -243,6 +683,8 @@ void SkillConfig::draw()
         if (perk_info.selected)
         {
             has_selected = true;
+            PerfScope scope(PerfZone::PerkInfo);
+            TraceZone zone("drawPerkInfo");
             drawPerkInfo(perk_info);
             break;
         }
@@ -252,32 +694,62 @@ void SkillConfig::draw()
         ImGui::Text("Select a perk to see more info.");
 }
 
-void SkillConfig::setLegendary()
+void SkillConfig::focusPerk(uint16_t num)
 {
-    auto player = RE::PlayerCharacter::GetSingleton();
+    for (auto& [perk_num, perk_info] : perks)
+        perk_info.selected = perk_num == num;
+    focus_node = num;
+}
 
-    g_skill_lvl->value = 0;
+void SkillConfig::restoreView(ImNodes::CanvasState& canvas)
+{
+    auto view = ViewStore::getSingleton()->find(path.string());
+    if (!view)
+        return;
+    canvas.Zoom   = view->zoom;
+    canvas.Offset = view->offset;
+    for (const auto& [num, pos] : view->node_pos)
+        if (auto iter = perks.find(num); iter != perks.end())
+            iter->second.pos = pos;
+}
 
-    for (auto& [num, perk_info] : perks)
-        for (auto newest_perk = perk_info.perk; newest_perk && player->HasPerk(newest_perk); newest_perk = newest_perk->nextPerk)
-        {
-            if (g_perk_pts)
-                g_perk_pts->value += 1;
-            else
-                player->GetGameStatsData().perkCount++;
-            player->RemovePerk(newest_perk);
-        }
+void SkillConfig::saveView(const ImNodes::CanvasState& canvas)
+{
+    TreeView view;
+    view.zoom   = canvas.Zoom;
+    view.offset = canvas.Offset;
+    for (const auto& [num, perk_info] : perks)
+        if (perk_info.pos.x != perk_info.default_pos.x || perk_info.pos.y != perk_info.default_pos.y)
+            view.node_pos[num] = perk_info.pos;
+    ViewStore::getSingleton()->update(path.string(), std::move(view));
+}
 
-    g_legend_cts->value += 1;
+void SkillConfig::setLegendary()
+{
+    if (sim)
+    {
+        sim->skill_lvl = 0;
+        for (const auto& [num, perk_info] : perks)
+            if (auto owned = getOwned(perk_info); owned > 0)
+            {
+                sim->perk_pts += owned;
+                sim->owned[num] = 0;
+            }
+        sim->legend_cts += 1;
+        updateFrontier(true);
+        plan_dirty = true;
+        return;
+    }
+
+    std::string_view failed_reason;
+    if (!send({CommandKind::SetLegendary}, failed_reason))
+        logger::warn("Failed to set {} legendary: {}", name, failed_reason);
 }
 
 void SkillConfig::drawPerkInfo(Perk& perk_info)
 {
-    auto player = RE::PlayerCharacter::GetSingleton();
-
-    auto newest_perk = perk_info.perk;
-    while (player->HasPerk(newest_perk) && newest_perk->nextPerk)
-        newest_perk = newest_perk->nextPerk;
+    const auto& rank      = perk_info.ranks[std::min<uint8_t>(getOwned(perk_info), perk_info.vers - 1)];
+    const auto& node_view = view.nodes[perk_info.idx];
 
     if (ImGui::BeginTable("Req", 2))
     {
@@ -290,24 +762,7 @@ void SkillConfig::drawPerkInfo(Perk& perk_info)
 
         ImGui::TableNextColumn();
         ImGui::AlignTextToFramePadding();
-        ImGui::Text("%s", newest_perk->GetName());
-
-        long skill_req  = 0;
-        long legend_req = 0;
-
-        for (auto conditem = newest_perk->perkConditions.head; conditem; conditem = conditem->next)
-        {
-            if ((conditem->data.functionData.function == RE::FUNCTION_DATA::FunctionID::kGetGlobalValue) &&
-                ((conditem->data.flags.opCode == RE::CONDITION_ITEM_DATA::OpCode::kGreaterThanOrEqualTo) ||
-                 (conditem->data.flags.opCode == RE::CONDITION_ITEM_DATA::OpCode::kEqualTo)))
-            {
-                auto param = std::bit_cast<ConditionParam>(conditem->data.functionData.params[0]).form;
-                if ((uintptr_t)param == (uintptr_t)g_skill_lvl)
-                    skill_req = std::lround(conditem->data.comparisonValue.f);
-                if ((uintptr_t)param == (uintptr_t)g_legend_cts)
-                    legend_req = std::lround(conditem->data.comparisonValue.f);
-            }
-        }
+        ImGui::TextUnformatted(rank.name.c_str());
 
         ImGui::TableNextColumn();
         ImGui::AlignTextToFramePadding();
@@ -315,7 +770,7 @@ void SkillConfig::drawPerkInfo(Perk& perk_info)
 
         ImGui::TableNextColumn();
         ImGui::AlignTextToFramePadding();
-        ImGui::Text("%ld", skill_req);
+        ImGui::TextUnformatted(node_view.skill_text.c_str());
 
         ImGui::TableNextColumn();
         ImGui::AlignTextToFramePadding();
@@ -323,10 +778,7 @@ void SkillConfig::drawPerkInfo(Perk& perk_info)
 
         ImGui::TableNextColumn();
         ImGui::AlignTextToFramePadding();
-        ImGui::Text("%ld", legend_req);
-
-        RE::BSString perk_desc = "";
-        newest_perk->GetDescription(perk_desc, newest_perk);
+        ImGui::TextUnformatted(node_view.legend_text.c_str());
 
         ImGui::TableNextColumn();
         ImGui::AlignTextToFramePadding();
@@ -334,7 +786,7 @@ void SkillConfig::drawPerkInfo(Perk& perk_info)
 
         ImGui::TableNextColumn();
         ImGui::AlignTextToFramePadding();
-        ImGui::TextWrapped("%s", perk_desc.c_str());
+        ImGui::TextWrapped("%s", rank.desc.c_str());
 
         ImGui::EndTable();
     }
@@ -342,47 +794,386 @@ void SkillConfig::drawPerkInfo(Perk& perk_info)
     static bool             get_perk_failed = false;
     static std::string_view failed_reason   = "";
     if (ImGui::Button("Get Perk"))
+        get_perk_failed = !buyRank(graph.num(perk_info.idx), failed_reason);
+    if (sim && getOwned(perk_info) > 0)
+    {
+        ImGui::SameLine();
+        if (ImGui::Button("Remove Rank"))
+        {
+            auto num        = graph.num(perk_info.idx);
+            sim->owned[num] = getOwned(perk_info) - 1;
+            sim->perk_pts += 1;
+            onRankChanged(num);
+            get_perk_failed = false;
+        }
+    }
+    if (get_perk_failed)
+    {
+        ImGui::SameLine();
+        ImGui::PushStyleColor(ImGuiCol_Text, error_color);
+        ImGui::Text(failed_reason.data());
+        ImGui::PopStyleColor();
+    }
+}
+
+bool SkillConfig::buyRank(uint16_t num, std::string_view& failed_reason)
+{
+    auto& perk_info = perks.at(num);
+    auto  owned     = getOwned(perk_info);
+    if (owned >= perk_info.vers)
+    {
+        failed_reason = "Perk already maxed!";
+        return false;
+    }
+
+    if (!sim)
+    {
+        // the game thread checks again with live values
+        if (getPerkPoints() <= 0)
+        {
+            failed_reason = "Not enough perk points!";
+            return false;
+        }
+        return send({CommandKind::Batch, slot, {{num, 1}}}, failed_reason);
+    }
+
+    if (!isEligible(perk_info))
+    {
+        failed_reason = "Perk condition not met!";
+        return false;
+    }
+    if (sim->perk_pts <= 0)
     {
-        if (!newest_perk->perkConditions.IsTrue(player, nullptr))
+        failed_reason = "Not enough perk points!";
+        return false;
+    }
+    sim->owned[num] = owned + 1;
+    sim->perk_pts -= 1;
+    onRankChanged(num);
+    game().playSound("UISkillsPerkSelect2D");
+    return true;
+}
+
+// Game thread only, the menu updates its own state from the command result
+bool SkillConfig::execute(const Command& cmd, CommandResult& result)
+{
+    auto& failed_reason = result.failed_reason;
+    switch (cmd.kind)
+    {
+        case CommandKind::Batch:
+            return applyBatch(cmd.changes, failed_reason, cmd.check_points);
+        case CommandKind::SetLegendary:
+        {
+            std::vector<RankChange> changes;
+            for (const auto& [num, perk_info] : perks)
+                if (auto owned = countOwned(perk_info); owned > 0)
+                    changes.push_back({num, -(int)owned});
+            if (!applyBatch(changes, failed_reason))
+                return false;
+            game().setGlobal(g_skill_lvl, 0);
+            if (g_legend_cts)
+                game().setGlobal(g_legend_cts, game().getGlobal(g_legend_cts) + 1);
+            return true;
+        }
+        case CommandKind::Commit:
         {
-            get_perk_failed = true;
-            failed_reason   = "Perk condition not met!";
+            // perk conditions read the level and legendary count, so those change first.
+            // Points are written once here, the simulation already paid for its ranks.
+            auto old_pts    = getLivePerkPoints();
+            auto old_lvl    = game().getGlobal(g_skill_lvl);
+            auto old_legend = g_legend_cts ? game().getGlobal(g_legend_cts) : 0.0f;
+            if (cmd.legend_cts > 0)
+                game().setGlobal(g_skill_lvl, 0);
+            if (g_legend_cts && cmd.legend_cts != 0)
+                game().setGlobal(g_legend_cts, std::max(old_legend + (float)cmd.legend_cts, 0.0f));
+            if (!applyBatch(cmd.changes, failed_reason, false, false))
+            {
+                game().setGlobal(g_skill_lvl, old_lvl);
+                if (g_legend_cts)
+                    game().setGlobal(g_legend_cts, old_legend);
+                return false;
+            }
+            if (cmd.perk_pts != 0)
+                setLivePerkPoints(old_pts + cmd.perk_pts);
+            return true;
         }
+        case CommandKind::CheckConditions:
+            for (const auto& [num, perk_info] : perks)
+                for (const auto& rank : perk_info.ranks)
+                    result.conds_met.push_back(!rank.other_conds || game().conditionsMet(rank.perk));
+            return true;
+    }
+    return false;
+}
+
+bool SkillConfig::send(Command cmd, std::string_view& failed_reason)
+{
+    cmd.slot = slot;
+    if (CommandQueue::getSingleton()->send(std::move(cmd)))
+        return true;
+    failed_reason = "Too many pending actions!";
+    return false;
+}
+
+void SkillConfig::onCommandDone(const CommandResult& result)
+{
+    if (result.ok)
+        cmd_failed.reset();
+    else
+    {
+        cmd_failed = result.failed_reason;
+        if (result.kind == CommandKind::Commit && committing && !sim)
+            sim = std::move(committing);
+    }
+    if (result.kind == CommandKind::Commit)
+        committing.reset();
+
+    if (result.kind == CommandKind::Batch && !sim)
+        for (auto num : result.touched)
+            onRankChanged(num);
+    else
+        syncOwned();
+}
+
+// All-or-nothing: point totals are checked once up front, every perk is added or removed,
+// then points are written once unless the caller writes them. Any failure puts removed perks back and takes added ones out.
+// Runs on the game thread, so ranks are counted from the player rather than the menu's copy.
+bool SkillConfig::applyBatch(const std::vector<RankChange>& changes, std::string_view& failed_reason, bool check_points, bool write_points)
+{
+    std::map<uint16_t, int> owned, targets;
+    for (const auto& change : changes)
+    {
+        auto iter = perks.find(change.num);
+        if (iter == perks.end())
+        {
+            failed_reason = "Unknown perk!";
+            return false;
+        }
+        if (!owned.contains(change.num))
+            owned[change.num] = countOwned(iter->second);
+        targets.try_emplace(change.num, owned[change.num]).first->second += change.delta;
+    }
+
+    long added = 0, removed = 0;
+    for (const auto& [num, target] : targets)
+    {
+        const auto& perk_info = perks.at(num);
+        if (target < 0 || target > perk_info.vers)
+        {
+            failed_reason = target < 0 ? "Perk not owned!" : "Perk already maxed!";
+            return false;
+        }
+        if (target > owned[num])
+            added += target - owned[num];
         else
+            removed += owned[num] - target;
+    }
+
+    long points = getLivePerkPoints() + removed - added;
+    if (check_points && points < 0)
+    {
+        failed_reason = "Not enough perk points!";
+        return false;
+    }
+
+    std::vector<PerkHandle> removed_perks, added_perks;
+    auto                    rollback = [&]() {
+        for (auto iter = added_perks.rbegin(); iter != added_perks.rend(); iter++)
+            game().removePerk(*iter);
+        for (auto iter = removed_perks.rbegin(); iter != removed_perks.rend(); iter++)
+            game().addPerk(*iter);
+    };
+
+    // removals first, highest rank down
+    for (const auto& [num, target] : targets)
+    {
+        const auto& perk_info = perks.at(num);
+        for (int rank = owned[num]; rank > target; rank--)
         {
-            if (g_perk_pts)
+            auto rank_perk = perk_info.ranks[rank - 1].perk;
+            game().removePerk(rank_perk);
+            removed_perks.push_back(rank_perk);
+        }
+    }
+
+    // additions in request order, so callers can put prerequisites first
+    std::map<uint16_t, int> applied;
+    for (const auto& change : changes)
+    {
+        if (change.delta <= 0)
+            continue;
+        const auto& perk_info = perks.at(change.num);
+        auto&       rank      = applied.try_emplace(change.num, owned[change.num]).first->second;
+        for (int i = 0; i < change.delta && rank < targets[change.num]; i++, rank++)
+        {
+            auto rank_perk = perk_info.ranks[rank].perk;
+            if (!game().conditionsMet(rank_perk))
             {
-                if (std::lround(g_perk_pts->value) > 0)
-                {
-                    player->AddPerk(newest_perk);
-                    g_perk_pts->value -= 1;
-                    get_perk_failed = false;
-                    RE::PlaySound("UISkillsPerkSelect2D");
-                }
-                else
-                {
-                    get_perk_failed = true;
-                    failed_reason   = "Not enough perk points!";
-                }
+                failed_reason = "Perk condition not met!";
+                rollback();
+                return false;
             }
-            else
+            game().addPerk(rank_perk);
+            if (!game().hasPerk(rank_perk))
             {
-                if (player->GetGameStatsData().perkCount > 0)
-                {
-                    player->AddPerk(newest_perk);
-                    player->GetGameStatsData().perkCount -= 1;
-                    get_perk_failed = false;
-                    RE::PlaySound("UISkillsPerkSelect2D");
-                }
-                else
+                failed_reason = "Failed to add perk!";
+                rollback();
+                return false;
+            }
+            added_perks.push_back(rank_perk);
+        }
+    }
+
+    if (write_points)
+        setLivePerkPoints(points);
+    if (added > 0)
+        game().playSound("UISkillsPerkSelect2D");
+    return true;
+}
+
+// Cheapest chain of missing ranks ending with the next rank of target. Any owned
+// prerequisite opens a node, so this is a 0-1 BFS up the parents where owned nodes cost
+// nothing, stopping at the first owned node or root.
+std::optional<PerkPlan> SkillConfig::makePlan(uint16_t target) const
+{
+    auto target_idx = graph.indexOf(target);
+    if (!target_idx || getOwned(perks.at(target)) >= perks.at(target).vers)
+        return std::nullopt;
+
+    constexpr uint16_t      unvisited = UINT16_MAX;
+    std::vector<uint16_t>   next(graph.size(), unvisited); // towards target
+    std::vector<uint32_t>   dist(graph.size(), UINT32_MAX);
+    std::deque<uint16_t>    queue;
+    std::optional<uint16_t> start;
+
+    dist[*target_idx] = 1;
+    next[*target_idx] = *target_idx;
+    queue.push_back(*target_idx);
+    while (!queue.empty())
+    {
+        auto idx = queue.front();
+        queue.pop_front();
+        const auto& perk_info = perks.at(graph.num(idx));
+        if (getOwned(perk_info) > 0 || graph.parents(idx).empty())
+        {
+            start = idx;
+            break;
+        }
+        for (auto parent : graph.parents(idx))
+        {
+            bool parent_owned = getOwned(perks.at(graph.num(parent))) > 0;
+            auto parent_dist  = dist[idx] + (parent_owned ? 0 : 1);
+            if (parent_dist >= dist[parent])
+                continue;
+            dist[parent] = parent_dist;
+            next[parent] = idx;
+            if (parent_owned)
+                queue.push_front(parent);
+            else
+                queue.push_back(parent);
+        }
+    }
+
+    PerkPlan plan;
+    plan.target = target;
+    if (!start)
+        return plan;
+
+    plan.reachable = true;
+    plan.on_path.assign(graph.size(), false);
+    for (auto idx = *start;; idx = next[idx])
+    {
+        auto        num       = graph.num(idx);
+        const auto& perk_info = perks.at(num);
+        plan.on_path[idx]     = true;
+        auto        owned     = getOwned(perk_info);
+        if (idx == *target_idx || owned == 0)
+        {
+            const auto& rank = perk_info.ranks[owned];
+            plan.steps.push_back(num);
+            plan.skill_req  = std::max(plan.skill_req, rank.skill_req);
+            plan.legend_req = std::max(plan.legend_req, rank.legend_req);
+        }
+        if (idx == *target_idx)
+            break;
+    }
+    return plan;
+}
+
+void SkillConfig::drawPlan()
+{
+    if (!plan)
+    {
+        ImGui::Text("Select a perk that is not maxed to plan for it.");
+        return;
+    }
+    if (!plan->reachable)
+    {
+        ImGui::PushStyleColor(ImGuiCol_Text, error_color);
+        ImGui::Text("No owned perk or root leads to this perk.");
+        ImGui::PopStyleColor();
+        return;
+    }
+
+    if (ImGui::BeginTable("Plan", 2))
+    {
+        ImGui::TableSetupColumn("1", 0, 1);
+        ImGui::TableSetupColumn("2", 0, 2);
+
+        for (size_t i = 0; i < plan->steps.size(); i++)
+        {
+            const auto& perk_info = perks.at(plan->steps[i]);
+
+            ImGui::TableNextColumn();
+            ImGui::Text("Step %zu:", i + 1);
+
+            ImGui::TableNextColumn();
+            auto        owned     = getOwned(perk_info);
+            ImGui::Text("%s (%d/%d)", perk_info.ranks[owned].name.c_str(), owned + 1, perk_info.vers);
+        }
+
+        ImGui::TableNextColumn();
+        ImGui::Text("Perk Points Needed:");
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu (have %ld)", plan->steps.size(), getPerkPoints());
+
+        ImGui::TableNextColumn();
+        ImGui::Text("Skill Needed:");
+        ImGui::TableNextColumn();
+        ImGui::Text("%ld", plan->skill_req);
+
+        ImGui::TableNextColumn();
+        ImGui::Text("Legendary Needed:");
+        ImGui::TableNextColumn();
+        ImGui::Text("%ld", plan->legend_req);
+
+        ImGui::EndTable();
+    }
+
+    static bool             apply_failed  = false;
+    static std::string_view failed_reason = "";
+    if (ImGui::Button("Apply Plan"))
+    {
+        // prerequisites come first
+        apply_failed = false;
+        if (sim)
+        {
+            for (auto num : plan->steps)
+                if (!buyRank(num, failed_reason))
                 {
-                    get_perk_failed = true;
-                    failed_reason   = "Not enough perk points!";
+                    apply_failed = true;
+                    break;
                 }
-            }
+        }
+        else
+        {
+            std::vector<RankChange> changes;
+            for (auto num : plan->steps)
+                changes.push_back({num, 1});
+            apply_failed = !send({CommandKind::Batch, slot, std::move(changes)}, failed_reason);
         }
     }
-    if (get_perk_failed)
+    if (apply_failed)
     {
         ImGui::SameLine();
         ImGui::PushStyleColor(ImGuiCol_Text, error_color);
@@ -393,43 +1184,238 @@ void SkillConfig::drawPerkInfo(Perk& perk_info)
 
 void ConfigReader::readAllConfig()
 {
+    readAllConfig(config_dir);
+}
+
+void ConfigReader::readAllConfig(const fs::path& dir)
+{
+    TraceZone zone("readAllConfig");
     logger::info("Reading configs!");
-    if (fs::exists(config_dir))
+    configs.clear();
+    auto manifest = ConfigManifest::getSingleton();
+    for (const auto& [path, parsed, layout_cache] : manifest->scan(dir))
     {
-        for (const auto& entry : fs::directory_iterator{config_dir})
+        logger::info("Reading {}", path.string());
+        SkillConfig config;
+        config.slot = configs.size();
+        config.path = path;
+        if (parsed)
+            config.resolve(path, *parsed, layout_cache);
+        config.diagnostics.logSummary(path.filename().string());
+        configs.push_back(config);
+    }
+    const auto& stats = manifest->last_scan;
+    logger::info("{} configs read, {} of them parsed, {} other files skipped.", configs.size(), stats.parsed, stats.entries - stats.configs);
+    manifest->save();
+
+    buildSearchIndex();
+}
+
+void ConfigReader::buildSearchIndex()
+{
+    TraceZone zone("buildSearchIndex");
+    search_index.clear();
+    for (uint16_t config_idx = 0; config_idx < configs.size(); config_idx++)
+    {
+        const auto& config = configs[config_idx];
+        if (!config.loaded)
+            continue;
+        for (const auto& [num, perk_info] : config.perks)
         {
-            if (entry.is_regular_file())
+            std::string names, descs;
+            for (const auto& rank : perk_info.ranks)
             {
-                auto filename = entry.path().filename().string();
-                std::transform(filename.begin(), filename.end(), filename.begin(), ::tolower);
-                if (filename.starts_with(config_prefix) && filename.ends_with(config_suffix))
-                {
-                    logger::info("Reading {}", entry.path().string());
-                    SkillConfig config;
-                    config.read(entry.path());
-                    configs.push_back(config);
-                }
+                names.append(rank.name).push_back('\n');
+                descs.append(rank.desc).push_back('\n');
+            }
+            search_index.add(config_idx, num, fmt::format("{} > {}", config.name, perk_info.ranks[0].name), names, descs);
+        }
+    }
+    search_index.finalize();
+    logger::info("{} perks indexed for search.", search_index.size());
+}
+
+void ConfigReader::drawSearch()
+{
+    static char search_buf[128] = "";
+    static bool search_desc     = false;
+
+    bool changed = ImGui::InputTextWithHint("##PerkSearch", "Search perks...", search_buf, sizeof(search_buf));
+    ImGui::SameLine();
+    changed |= ImGui::Checkbox("Descriptions", &search_desc);
+    if (changed)
+        search_index.query(search_buf, search_desc, 100, search_results);
+
+    if (search_buf[0] == '\0')
+        return;
+
+    if (search_results.empty())
+        ImGui::Text("No perk found.");
+    else if (ImGui::BeginListBox("##SearchResults", ImVec2(-1.0f, 5.5f * ImGui::GetTextLineHeightWithSpacing())))
+    {
+        for (const auto& hit : search_results)
+        {
+            ImGui::PushID(&hit);
+            if (ImGui::Selectable(hit.label.c_str()))
+            {
+                jump_config = hit.config;
+                configs[hit.config].focusPerk(hit.node);
             }
+            ImGui::PopID();
         }
+        ImGui::EndListBox();
     }
-    logger::info("{} configs read.", configs.size());
+}
+
+void ConfigReader::refreshSummaries()
+{
+    summaries.resize(configs.size());
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        const auto& config = configs[i];
+        if (!config.loaded)
+            continue;
+        summaries[i].level    = std::lround(globals.get(i, GlobalField::SkillLevel));
+        summaries[i].perk_pts = config.getPerkPoints();
+    }
+    summary_time = ImGui::GetTime();
+}
+
+void ConfigReader::sortSkillList(const ImGuiTableSortSpecs* specs)
+{
+    if (list_order.size() != configs.size())
+    {
+        list_order.resize(configs.size());
+        std::iota(list_order.begin(), list_order.end(), 0);
+    }
+    if (!specs || specs->SpecsCount == 0)
+        return;
+
+    auto column    = specs->Specs[0].ColumnIndex;
+    bool ascending = specs->Specs[0].SortDirection == ImGuiSortDirection_Ascending;
+    auto less      = [&](size_t a, size_t b) {
+        switch (column)
+        {
+            case 1: return summaries[a].level < summaries[b].level;
+            case 2: return summaries[a].perk_pts < summaries[b].perk_pts;
+            default: return configs[a].name < configs[b].name;
+        }
+    };
+    std::stable_sort(list_order.begin(), list_order.end(), [&](size_t a, size_t b) { return ascending ? less(a, b) : less(b, a); });
+}
+
+void ConfigReader::drawSkillList()
+{
+    bool refreshed = false;
+    if (summaries.size() != configs.size() || globals.any_changed || ImGui::GetTime() - summary_time > summary_interval)
+    {
+        refreshSummaries();
+        refreshed = true;
+    }
+
+    auto flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter;
+    if (ImGui::BeginTable("SkillList", 3, flags, ImVec2(0.0f, 8.5f * ImGui::GetTextLineHeightWithSpacing())))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Skill", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthStretch, 3);
+        ImGui::TableSetupColumn("Level", ImGuiTableColumnFlags_WidthStretch, 1);
+        ImGui::TableSetupColumn("Perk Points", ImGuiTableColumnFlags_WidthStretch, 1);
+        ImGui::TableHeadersRow();
+
+        if (auto specs = ImGui::TableGetSortSpecs(); specs && (specs->SpecsDirty || refreshed || list_order.size() != configs.size()))
+        {
+            sortSkillList(specs);
+            specs->SpecsDirty = false;
+        }
+
+        // only rows in view are laid out
+        ImGuiListClipper clipper;
+        clipper.Begin((int)list_order.size());
+        while (clipper.Step())
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                auto        idx     = list_order[row];
+                const auto& summary = summaries[idx];
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::PushID((int)idx);
+                if (ImGui::Selectable(configs[idx].name.c_str(), list_selected == idx, ImGuiSelectableFlags_SpanAllColumns))
+                    list_selected = idx;
+                ImGui::PopID();
+                ImGui::TableNextColumn();
+                if (summary.level >= 0)
+                    ImGui::Text("%ld", summary.level);
+                else
+                    ImGui::TextUnformatted("-");
+                ImGui::TableNextColumn();
+                if (summary.level >= 0)
+                    ImGui::Text("%ld", summary.perk_pts);
+                else
+                    ImGui::TextUnformatted("-");
+            }
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+    if (list_selected < configs.size())
+        configs[list_selected].draw();
 }
 
 void ConfigReader::draw()
 {
-    static ImNodes::Ez::Context* context = ImNodes::Ez::CreateContext();
+    PerfScope scope(PerfZone::MenuDraw);
+    TraceZone zone("ConfigReader::draw");
+    InputRecorder::getSingleton()->capture();
+    GlobalSnapshot::getSingleton()->read(globals);
+    CommandResult result;
+    while (CommandQueue::getSingleton()->receive(result))
+        if (result.kind == CommandKind::CheckConditions)
+            InputRecorder::getSingleton()->onConditions(result);
+        else if (result.slot < configs.size())
+            configs[result.slot].onCommandDone(result);
     if (configs.size() > 0)
     {
-        if (ImGui::BeginTabBar("Skills", ImGuiTabBarFlags_None))
+        ImGui::Checkbox("List View", &use_list);
+        ImGui::SameLine();
+        if (bool show_perf = PerfStats::getSingleton()->enabled(); ImGui::Checkbox("Performance", &show_perf))
+            PerfStats::getSingleton()->setEnabled(show_perf);
+        ImGui::SameLine();
+        if (TraceRecorder::getSingleton()->recording())
+            ImGui::TextUnformatted("Recording trace...");
+        else if (ImGui::Button("Record Trace"))
+            TraceRecorder::getSingleton()->start(trace_window);
+        ImGui::SameLine();
+        if (auto recorder = InputRecorder::getSingleton(); recorder->recording())
+        {
+            if (ImGui::Button("Stop Input"))
+                recorder->stop();
+        }
+        else if (ImGui::Button("Record Input"))
+            recorder->start(*this);
+        drawSearch();
+
+        if (use_list)
+        {
+            if (jump_config)
+                list_selected = *jump_config;
+            jump_config.reset();
+            drawSkillList();
+        }
+        else if (ImGui::BeginTabBar("Skills", ImGuiTabBarFlags_None))
         {
-            for (auto& config : configs)
+            for (size_t i = 0; i < configs.size(); i++)
             {
-                if (ImGui::BeginTabItem(config.name.c_str()))
+                auto& config = configs[i];
+                auto  flags  = jump_config == i ? ImGuiTabItemFlags_SetSelected : ImGuiTabItemFlags_None;
+                if (ImGui::BeginTabItem(config.name.c_str(), nullptr, flags))
                 {
+                    shown_tab = i;
                     config.draw();
                     ImGui::EndTabItem();
                 }
             }
+            jump_config.reset();
             ImGui::EndTabBar();
         }
     }
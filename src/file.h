@@ -1,42 +1,228 @@
 #pragma once
 
+#include "game.h"
+#include "graph.h"
+#include "layout.h"
+#include "search.h"
+#include "snapshot.h"
+#include "viewmodel.h"
+
 #include <filesystem>
 
+namespace ImNodes
+{
+struct CanvasState;
+} // namespace ImNodes
+
 namespace minskill
 {
 namespace fs = std::filesystem;
 
+struct PerkRank
+{
+    PerkHandle  perk;
+    long        skill_req   = 0;
+    long        legend_req  = 0;
+    bool        other_conds = false; // has conditions besides skill & legendary requirements
+    std::string name;
+    std::string desc; // read once at load
+};
+
 struct Perk
 {
     std::vector<uint16_t> links;
-    RE::BGSPerk*          perk;
-    uint8_t               vers = 0;
+    PerkHandle            perk;
+    std::vector<PerkRank> ranks;
+    uint16_t              idx   = 0; // index in SkillConfig::graph
+    uint8_t               vers  = 0;
+    uint8_t               owned = 0;
     ImVec2                pos;
+    ImVec2                default_pos; // position from config
     bool                  selected = false;
+    bool                  eligible = false; // next rank requirements met, perk points aside
 };
 
+struct PerkPlan
+{
+    uint16_t              target;
+    bool                  reachable = false;
+    std::vector<uint16_t> steps;   // node numbers, one rank each, in purchase order
+    std::vector<bool>     on_path; // by graph index, includes the owned node the path starts from
+    long                  skill_req  = 0;
+    long                  legend_req = 0;
+};
+
+struct RankChange
+{
+    uint16_t num;
+    int      delta; // ranks to add, negative to remove
+};
+
+enum class CommandKind : uint8_t
+{
+    Batch,        // buy or refund ranks
+    SetLegendary,   // refund every rank, reset the level
+    Commit,         // batch from a simulation, then its globals
+    CheckConditions // other conditions of every rank, for the input recorder
+};
+
+// Game state change requested by the menu, see CommandQueue
+struct Command
+{
+    CommandKind             kind = CommandKind::Batch;
+    size_t                  slot = 0; // config
+    std::vector<RankChange> changes;
+    bool                    check_points = true;
+    long                    perk_pts     = 0; // Commit: points changed in the simulation, ranks bought or refunded included
+    long                    legend_cts   = 0; // Commit: legendary count gained, resets the level
+};
+
+struct CommandResult
+{
+    CommandKind           kind = CommandKind::Batch;
+    size_t                slot = 0;
+    bool                  ok   = false;
+    std::string_view      failed_reason;
+    std::vector<uint16_t> touched;   // node numbers whose ranks may have changed
+    std::vector<bool>     conds_met; // CheckConditions: every rank of every perk, in node order
+};
+
+// Hypothetical state read in place of the game's, perks are copied in only once changed
+struct Simulation
+{
+    std::unordered_map<uint16_t, uint8_t> owned; // by node number
+    long                                  perk_pts        = 0;
+    long                                  skill_lvl       = 0;
+    long                                  legend_cts      = 0;
+    long                                  base_perk_pts   = 0; // values the simulation started from
+    long                                  base_legend_cts = 0;
+};
+
+// Watched global values the purchasable frontier was evaluated with
+struct FrontierState
+{
+    long skill_lvl  = -1;
+    long legend_cts = -1;
+
+    bool operator==(const FrontierState&) const = default;
+};
+
+struct FormRef
+{
+    std::string plugin;
+    uint32_t    id = 0;
+};
+
+// Enabled node of a config file, before its perk is looked up
+struct ParsedNode
+{
+    uint16_t              num = 0;
+    FormRef               perk;
+    bool                  has_pos = false;
+    int                   gridx = 0, gridy = 0;
+    float                 x = 0, y = 0;
+    std::vector<uint16_t> links;
+};
+
+// Config file contents without anything from the game, so it can be kept between runs
+struct ParsedConfig
+{
+    std::string             name;
+    std::string             desc;
+    FormRef                 skill_lvl;
+    FormRef                 lvl_ratio;
+    FormRef                 show_lvl_up;
+    FormRef                 perk_pts;
+    FormRef                 legend_cts;
+    std::vector<ParsedNode> nodes; // by number
+};
+
+// Logs & returns nullopt when the file isn't valid TOML
+std::optional<ParsedConfig> parseConfig(const fs::path& path);
 
 struct SkillConfig
 {
     bool     loaded = false;
     fs::path path;
+    size_t   slot   = 0; // in the global snapshot
 
     std::string name = "Failed";
     std::string desc;
+    Diagnostics diagnostics;
     // global vars
-    RE::TESGlobal* g_skill_lvl;
-    RE::TESGlobal* g_lvl_ratio;
-    RE::TESGlobal* g_show_lvl_up;
-    RE::TESGlobal* g_perk_pts;
-    RE::TESGlobal* g_legend_cts;
+    GlobalHandle g_skill_lvl;
+    GlobalHandle g_lvl_ratio;
+    GlobalHandle g_show_lvl_up;
+    GlobalHandle g_perk_pts;
+    GlobalHandle g_legend_cts;
 
     std::map<uint16_t, Perk> perks;
+    PerkGraph                graph;
+
+    std::optional<uint16_t> hovered_idx; // perk hovered last frame
+
+    std::optional<uint16_t> focus_node; // node to center on next draw
+
+    FrontierState frontier_state;
+    int           last_draw_frame = -1;
+
+    TreeViewModel view;
+    uint64_t      view_gen   = 0;
+    bool          view_dirty = true;
+    bool          view_pts   = false; // had perk points when the view was requested
+
+    bool                    plan_mode  = false;
+    bool                    plan_dirty = false;
+    std::optional<PerkPlan> plan;
+
+    std::optional<Simulation> sim;
+    std::optional<Simulation> committing; // restored if the commit fails
+
+    std::optional<std::string_view> cmd_failed; // from the last failed command
 
     void read(const fs::path& path);
+    // Looks up the forms of a parsed file and builds the tree
+    void resolve(const fs::path& path, const ParsedConfig& parsed, LayoutCache* layout_cache = nullptr);
+    void readRanks(Perk& perk_info);
     void draw();
 
+    long    getLivePerkPoints() const;
+    void    setLivePerkPoints(long points);
+    long    getPerkPoints() const;
+    long    getSkillLevel() const;
+    long    getLegendCount() const;
+    uint8_t getOwned(const Perk& perk_info) const;
+    void    syncOwned();
+    void    onRankChanged(uint16_t num);
+    void    updateFrontier(bool force = false);
+    bool    isEligible(const Perk& perk_info) const;
+
+    ViewInput makeViewInput(long perk_pts);
+
+    void beginSimulation();
+    void discardSimulation();
+    bool commitSimulation(std::string_view& failed_reason);
+
+    void focusPerk(uint16_t num);
+    void restoreView(ImNodes::CanvasState& canvas);
+    void saveView(const ImNodes::CanvasState& canvas);
+
     void drawPerkInfo(Perk& perk);
     void setLegendary();
+
+    bool                    send(Command cmd, std::string_view& failed_reason);
+    void                    onCommandDone(const CommandResult& result);
+    bool                    execute(const Command& cmd, CommandResult& result);
+    bool                    applyBatch(const std::vector<RankChange>& changes, std::string_view& failed_reason, bool check_points = true, bool write_points = true);
+    bool                    buyRank(uint16_t num, std::string_view& failed_reason);
+    std::optional<PerkPlan> makePlan(uint16_t target) const;
+    void                    drawPlan();
+};
+
+struct SkillSummary
+{
+    long level    = -1;
+    long perk_pts = 0;
 };
 
 class ConfigReader
@@ -49,9 +235,30 @@ public:
     }
 
     void readAllConfig();
+    // Replaces the loaded configs with the ones found in dir
+    void readAllConfig(const fs::path& dir);
     void draw();
 
+    void buildSearchIndex();
+    void drawSearch();
+
+    void refreshSummaries();
+    void sortSkillList(const ImGuiTableSortSpecs* specs);
+    void drawSkillList();
+
     std::vector<SkillConfig> configs;
+    GlobalValues             globals; // snapshot read at the start of each draw
+
+    PerkSearchIndex        search_index;
+    std::vector<SearchHit> search_results;
+    std::optional<size_t>  jump_config; // tab to select next draw
+    size_t                 shown_tab = 0;
+
+    bool                      use_list      = false; // list selector instead of tabs
+    size_t                    list_selected = 0;
+    std::vector<size_t>       list_order;
+    std::vector<SkillSummary> summaries;
+    double                    summary_time = -1.0;
 };
 
 } // namespace minskill
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "game.h"
+
+namespace minskill
+{
+static GameInterface*                       game_impl = nullptr;
+static std::optional<std::filesystem::path> log_dir;
+
+GameInterface& game()
+{
+    return *game_impl;
+}
+
+void setGame(GameInterface* impl)
+{
+    game_impl = impl;
+}
+
+std::optional<std::filesystem::path> logDirectory()
+{
+    return log_dir;
+}
+
+void setLogDirectory(std::filesystem::path dir)
+{
+    log_dir = std::move(dir);
+}
+} // namespace minskill
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "diagnostics.h"
+
+namespace minskill
+{
+// Game objects are opaque outside of the game interface
+using GlobalHandle = void*;
+using PerkHandle   = void*;
+
+struct PerkRequirements
+{
+    long skill_req   = 0;
+    long legend_req  = 0;
+    bool other_conds = false; // has conditions besides skill & legendary requirements
+};
+
+// Everything the menu needs from the game. The plugin talks to Skyrim through SkyrimGame,
+// tools and benchmarks use the in-memory StubGame.
+class GameInterface
+{
+public:
+    virtual ~GameInterface() = default;
+
+    // Problems go to diag when given, so repeated ones are summarized instead of logged each time
+    virtual GlobalHandle findGlobal(const std::string& plugin, uint32_t form_id, Diagnostics* diag) = 0;
+    virtual PerkHandle   findPerk(const std::string& plugin, uint32_t form_id, Diagnostics* diag)   = 0;
+
+    virtual float getGlobal(GlobalHandle global)            = 0;
+    virtual void  setGlobal(GlobalHandle global, float val) = 0;
+
+    virtual PerkHandle       nextRank(PerkHandle perk)                                                     = 0;
+    virtual std::string      perkName(PerkHandle perk)                                                     = 0;
+    virtual std::string      perkDescription(PerkHandle perk)                                              = 0;
+    virtual PerkRequirements requirements(PerkHandle perk, GlobalHandle skill_lvl, GlobalHandle legend_cts) = 0;
+
+    // Player state
+    virtual bool conditionsMet(PerkHandle perk) = 0;
+    virtual bool hasPerk(PerkHandle perk)       = 0;
+    virtual void addPerk(PerkHandle perk)       = 0;
+    virtual void removePerk(PerkHandle perk)    = 0;
+    virtual long perkPoints()                   = 0; // used when a config has no perk point global
+    virtual void setPerkPoints(long points)     = 0;
+
+    virtual void playSound(const char* sound) = 0;
+    // HUD message with a sound, shown after the current update
+    virtual void notify(std::string msg, const char* sound) = 0;
+};
+
+GameInterface& game();
+void           setGame(GameInterface* impl);
+
+// Directory of the plugin's log, set by the plugin at load. Traces, recordings and caches go
+// there; tools and benchmarks leave it unset and nothing is written.
+std::optional<std::filesystem::path> logDirectory();
+void                                 setLogDirectory(std::filesystem::path dir);
+} // namespace minskill
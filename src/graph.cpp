@@ -0,0 +1,97 @@
+#include "graph.h"
+
+namespace minskill
+{
+std::optional<uint16_t> PerkGraph::indexOf(uint16_t num) const
+{
+    if (auto iter = index.find(num); iter != index.end())
+        return iter->second;
+    return std::nullopt;
+}
+
+PerkGraph::Relation PerkGraph::relation(uint16_t src, uint16_t idx) const
+{
+    if (src == idx)
+        return Relation::Self;
+    if (isAncestor(idx, src))
+        return Relation::Ancestor;
+    if (isDescendant(idx, src))
+        return Relation::Descendant;
+    return Relation::None;
+}
+
+void PerkGraph::build(const std::map<uint16_t, std::vector<uint16_t>>& links)
+{
+    nums.clear();
+    index.clear();
+    for (const auto& [num, outs] : links)
+    {
+        index[num] = (uint16_t)nums.size();
+        nums.push_back(num);
+    }
+
+    size_t n = nums.size();
+    child_lists.assign(n, {});
+    parent_lists.assign(n, {});
+    for (const auto& [num, outs] : links)
+        for (auto out : outs)
+            if (auto iter = index.find(out); iter != index.end())
+            {
+                child_lists[index[num]].push_back(iter->second);
+                parent_lists[iter->second].push_back(index[num]);
+            }
+
+    // Kahn order, nodes stuck in cycles go last and are settled by repeated passes
+    std::vector<uint16_t> order;
+    std::vector<uint16_t> in_deg(n);
+    for (size_t i = 0; i < n; i++)
+        in_deg[i] = (uint16_t)parent_lists[i].size();
+    for (size_t i = 0; i < n; i++)
+        if (in_deg[i] == 0)
+            order.push_back((uint16_t)i);
+    for (size_t head = 0; head < order.size(); head++)
+        for (auto child : child_lists[order[head]])
+            if (--in_deg[child] == 0)
+                order.push_back(child);
+    for (size_t i = 0; i < n; i++)
+        if (in_deg[i] > 0)
+            order.push_back((uint16_t)i);
+
+    topo_pos.resize(n);
+    for (size_t i = 0; i < n; i++)
+        topo_pos[order[i]] = (uint16_t)i;
+
+    words = (n + 63) / 64;
+    closure(parent_lists, order, anc_bits);
+    std::reverse(order.begin(), order.end());
+    closure(child_lists, order, desc_bits);
+}
+
+// Row of each node is the union of its neighbors' rows and the neighbors themselves.
+// Visiting in order settles a DAG in one pass, cycles need a few more.
+void PerkGraph::closure(const std::vector<std::vector<uint16_t>>& edges, const std::vector<uint16_t>& order, std::vector<uint64_t>& bits)
+{
+    bits.assign(nums.size() * words, 0);
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (auto idx : order)
+        {
+            auto row = &bits[idx * words];
+            for (auto other : edges[idx])
+            {
+                auto other_row = &bits[other * words];
+                for (size_t w = 0; w < words; w++)
+                {
+                    auto merged = row[w] | other_row[w];
+                    if (w == other / 64)
+                        merged |= 1ull << (other % 64);
+                    changed |= merged != row[w];
+                    row[w] = merged;
+                }
+            }
+        }
+    }
+}
+} // namespace minskill
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <unordered_map>
+
+namespace minskill
+{
+// Perk link graph with dense node indices and precomputed transitive closure
+class PerkGraph
+{
+public:
+    enum class Relation : uint8_t
+    {
+        None,
+        Self,
+        Ancestor,  // prerequisite of the source, directly or not
+        Descendant // depends on the source, directly or not
+    };
+
+    void build(const std::map<uint16_t, std::vector<uint16_t>>& links);
+
+    size_t                  size() const { return nums.size(); }
+    uint16_t                num(uint16_t idx) const { return nums[idx]; }
+    std::optional<uint16_t> indexOf(uint16_t num) const;
+
+    const std::vector<uint16_t>& children(uint16_t idx) const { return child_lists[idx]; }
+    const std::vector<uint16_t>& parents(uint16_t idx) const { return parent_lists[idx]; }
+    // position in a prerequisite-first order, nodes in cycles come last
+    uint16_t                     topoPos(uint16_t idx) const { return topo_pos[idx]; }
+
+    bool     isAncestor(uint16_t anc, uint16_t idx) const { return test(anc_bits, idx, anc); }
+    bool     isDescendant(uint16_t desc, uint16_t idx) const { return test(desc_bits, idx, desc); }
+    Relation relation(uint16_t src, uint16_t idx) const;
+
+private:
+    bool test(const std::vector<uint64_t>& bits, uint16_t row, uint16_t col) const
+    {
+        return (bits[row * words + col / 64] >> (col % 64)) & 1;
+    }
+    void closure(const std::vector<std::vector<uint16_t>>& edges, const std::vector<uint16_t>& order, std::vector<uint64_t>& bits);
+
+    std::vector<uint16_t>                  nums;
+    std::unordered_map<uint16_t, uint16_t> index;
+    std::vector<std::vector<uint16_t>>     child_lists;
+    std::vector<std::vector<uint16_t>>     parent_lists;
+    std::vector<uint16_t>                  topo_pos;
+
+    size_t                words = 0; // 64-bit words per row
+    std::vector<uint64_t> anc_bits;  // row i: every ancestor of i
+    std::vector<uint64_t> desc_bits; // row i: every descendant of i
+};
+} // namespace minskill
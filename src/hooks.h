@@ -1,28 +1,35 @@
 #pragma once
 
-#include "file.h"
+#include "commands.h"
+#include "notify.h"
+#include "perfstats.h"
+#include "trace.h"
 namespace minskill
 {
+// Runs once on the game thread in the update the game starts quitting in
+void onQuit();
+
 struct UpdateHook
 {
     inline static void thunk(RE::Main* a_this, float a2)
     {
         func(a_this, a2);
-        for (const auto& skill_config : ConfigReader::getSingleton()->configs)
-            if (skill_config.loaded)
-            {
-                auto val = std::lround(skill_config.g_show_lvl_up->value);
-                if (val > 0)
-                {
-                    RE::DebugNotification(fmt::format("Skill \"{}\" has reached lvl. {}", skill_config.name, val).c_str());
-                    RE::PlaySound("UISkillIncreaseSD");
-                    skill_config.g_show_lvl_up->value = 0;
-                }
-            }
+        if (a_this->quitGame)
+        {
+            static std::once_flag quit_once;
+            std::call_once(quit_once, onQuit);
+            return;
+        }
+        PerfScope scope(PerfZone::UpdateHook);
+        TraceZone zone("UpdateHook");
+        CommandQueue::getSingleton()->drain();
+        GlobalSnapshot::getSingleton()->sample();
+        LevelUpWatcher::getSingleton()->update();
+        TraceRecorder::getSingleton()->update();
     }
     static inline REL::Relocation<decltype(thunk)> func;
 
     static constexpr auto id     = RELOCATION_ID(35551, 36544);
     static constexpr auto offset = REL::VariantOffset(0x11F, 0x160, 0);
 };
-} // namespace minskill
\ No newline at end of file
+} // namespace minskill
@@ -0,0 +1,327 @@
+#include "layout.h"
+
+#include <set>
+#include <unordered_map>
+
+namespace minskill
+{
+constexpr int order_sweeps = 8; // barycenter sweeps, alternating down and up
+constexpr int coord_sweeps = 4;
+constexpr int max_span     = 8; // longer links get no dummy chain and are left out of the ordering
+
+struct LayeredGraph
+{
+    std::vector<int>              layer;
+    std::vector<std::vector<int>> up;   // neighbors in layer - 1
+    std::vector<std::vector<int>> down; // neighbors in layer + 1
+    std::vector<std::vector<int>> layers;
+};
+
+// Orders nodes with the Eades-Lin-Smyth heuristic: sinks go to the back, sources to the front,
+// otherwise the node with the most outgoing over incoming links. Links against that order are
+// reversed rather than dropped, so they still pull their nodes together.
+static std::vector<std::vector<int>> breakCycles(const std::vector<std::vector<int>>& adj)
+{
+    size_t                        n = adj.size();
+    std::vector<std::vector<int>> in(n);
+    std::vector<int>              in_deg(n, 0), out_deg(n, 0);
+    for (size_t u = 0; u < n; u++)
+        for (auto v : adj[u])
+        {
+            in[v].push_back((int)u);
+            out_deg[u]++;
+            in_deg[v]++;
+        }
+
+    std::set<std::pair<int, int>> by_delta; // (in - out, node), the first is the best source
+    std::vector<int>              sinks, sources;
+    for (size_t i = 0; i < n; i++)
+    {
+        by_delta.insert({in_deg[i] - out_deg[i], (int)i});
+        if (out_deg[i] == 0)
+            sinks.push_back((int)i);
+        else if (in_deg[i] == 0)
+            sources.push_back((int)i);
+    }
+
+    std::vector<bool> removed(n, false);
+    auto              update = [&](int u, int& deg, std::vector<int>& became_empty) {
+        by_delta.erase({in_deg[u] - out_deg[u], u});
+        if (--deg == 0)
+            became_empty.push_back(u);
+        by_delta.insert({in_deg[u] - out_deg[u], u});
+    };
+    auto remove = [&](int u) {
+        removed[u] = true;
+        by_delta.erase({in_deg[u] - out_deg[u], u});
+        for (auto v : adj[u])
+            if (!removed[v])
+                update(v, in_deg[v], sources);
+        for (auto w : in[u])
+            if (!removed[w])
+                update(w, out_deg[w], sinks);
+    };
+
+    std::vector<int> front, back;
+    while (!by_delta.empty())
+    {
+        while (!sinks.empty() || !sources.empty())
+        {
+            auto& list = sinks.empty() ? sources : sinks;
+            int   u    = list.back();
+            list.pop_back();
+            if (removed[u])
+                continue;
+            (&list == &sinks ? back : front).push_back(u);
+            remove(u);
+        }
+        if (!by_delta.empty())
+        {
+            int u = by_delta.begin()->second;
+            front.push_back(u);
+            remove(u);
+        }
+    }
+
+    std::vector<int> order(n);
+    int              next = 0;
+    for (auto u : front)
+        order[u] = next++;
+    for (auto iter = back.rbegin(); iter != back.rend(); iter++)
+        order[*iter] = next++;
+
+    std::vector<std::vector<int>> dag(n);
+    for (size_t u = 0; u < n; u++)
+        for (auto v : adj[u])
+        {
+            if (order[u] < order[v])
+                dag[u].push_back(v);
+            else
+                dag[v].push_back((int)u);
+        }
+    return dag;
+}
+
+// Longest path layering, edges over a few layers are split with dummy nodes
+static LayeredGraph assignLayers(const std::vector<std::vector<int>>& dag)
+{
+    size_t           n = dag.size();
+    std::vector<int> in_deg(n, 0);
+    for (const auto& outs : dag)
+        for (auto v : outs)
+            in_deg[v]++;
+
+    LayeredGraph graph;
+    graph.layer.assign(n, 0);
+    std::vector<int> queue;
+    for (size_t i = 0; i < n; i++)
+        if (in_deg[i] == 0)
+            queue.push_back((int)i);
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        int u = queue[head];
+        for (auto v : dag[u])
+        {
+            graph.layer[v] = std::max(graph.layer[v], graph.layer[u] + 1);
+            if (--in_deg[v] == 0)
+                queue.push_back(v);
+        }
+    }
+
+    graph.up.resize(n);
+    graph.down.resize(n);
+    for (size_t u = 0; u < n; u++)
+        for (auto v : dag[u])
+        {
+            if (graph.layer[v] - graph.layer[u] > max_span)
+                continue;
+            int prev = (int)u;
+            for (int l = graph.layer[u] + 1; l < graph.layer[v]; l++)
+            {
+                int dummy = (int)graph.layer.size();
+                graph.layer.push_back(l);
+                graph.up.push_back({prev});
+                graph.down.push_back({});
+                graph.down[prev].push_back(dummy);
+                prev = dummy;
+            }
+            graph.down[prev].push_back(v);
+            graph.up[v].push_back(prev);
+        }
+
+    int max_layer = graph.layer.empty() ? 0 : *std::max_element(graph.layer.begin(), graph.layer.end());
+    graph.layers.resize(max_layer + 1);
+    for (size_t i = 0; i < graph.layer.size(); i++)
+        graph.layers[graph.layer[i]].push_back((int)i);
+    return graph;
+}
+
+// Crossings between a layer and the next one, counted as inversions with a Fenwick tree
+static size_t countCrossings(const LayeredGraph& graph, const std::vector<int>& pos, size_t l)
+{
+    std::vector<std::pair<int, int>> edges;
+    for (auto u : graph.layers[l])
+        for (auto v : graph.down[u])
+            edges.push_back({pos[u], pos[v]});
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<int> tree(graph.layers[l + 1].size() + 1, 0);
+    size_t           crossings = 0;
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        // every earlier edge ending further down crosses this one
+        int not_crossing = 0;
+        for (int k = edges[i].second + 1; k > 0; k -= k & -k)
+            not_crossing += tree[k];
+        crossings += i - not_crossing;
+        for (int k = edges[i].second + 1; k < (int)tree.size(); k += k & -k)
+            tree[k]++;
+    }
+    return crossings;
+}
+
+static size_t countAllCrossings(const LayeredGraph& graph, const std::vector<int>& pos)
+{
+    size_t crossings = 0;
+    for (size_t l = 0; l + 1 < graph.layers.size(); l++)
+        crossings += countCrossings(graph, pos, l);
+    return crossings;
+}
+
+static void sortByBarycenter(std::vector<int>& layer_nodes, const std::vector<std::vector<int>>& neighbors, std::vector<int>& pos)
+{
+    std::vector<std::pair<float, int>> keyed;
+    keyed.reserve(layer_nodes.size());
+    for (auto u : layer_nodes)
+    {
+        // nodes without neighbors on that side keep their place
+        float bary = (float)pos[u];
+        if (!neighbors[u].empty())
+        {
+            bary = 0;
+            for (auto v : neighbors[u])
+                bary += pos[v];
+            bary /= neighbors[u].size();
+        }
+        keyed.push_back({bary, u});
+    }
+    std::stable_sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (size_t i = 0; i < keyed.size(); i++)
+    {
+        layer_nodes[i]       = keyed[i].second;
+        pos[keyed[i].second] = (int)i;
+    }
+}
+
+static void reduceCrossings(LayeredGraph& graph)
+{
+    std::vector<int> pos(graph.layer.size());
+    for (const auto& layer_nodes : graph.layers)
+        for (size_t i = 0; i < layer_nodes.size(); i++)
+            pos[layer_nodes[i]] = (int)i;
+
+    auto best_layers    = graph.layers;
+    auto best_crossings = countAllCrossings(graph, pos);
+    for (int sweep = 0; sweep < order_sweeps && best_crossings > 0; sweep++)
+    {
+        if (sweep % 2 == 0)
+            for (size_t l = 1; l < graph.layers.size(); l++)
+                sortByBarycenter(graph.layers[l], graph.up, pos);
+        else
+            for (size_t l = graph.layers.size() - 1; l-- > 0;)
+                sortByBarycenter(graph.layers[l], graph.down, pos);
+
+        auto crossings = countAllCrossings(graph, pos);
+        if (crossings < best_crossings)
+        {
+            best_crossings = crossings;
+            best_layers    = graph.layers;
+        }
+    }
+    graph.layers = std::move(best_layers);
+}
+
+// Pulls each row towards its neighbors' average while keeping order and a gap of one row
+static std::vector<float> assignRows(const LayeredGraph& graph)
+{
+    std::vector<float> row(graph.layer.size());
+    for (const auto& layer_nodes : graph.layers)
+        for (size_t i = 0; i < layer_nodes.size(); i++)
+            row[layer_nodes[i]] = (float)i;
+
+    std::vector<float> wanted, fwd, bwd;
+    for (int sweep = 0; sweep < coord_sweeps * 2; sweep++)
+    {
+        bool        going_down = sweep % 2 == 0;
+        const auto& neighbors  = going_down ? graph.up : graph.down;
+        for (size_t k = 0; k < graph.layers.size(); k++)
+        {
+            const auto& layer_nodes = graph.layers[going_down ? k : graph.layers.size() - 1 - k];
+            size_t      cts         = layer_nodes.size();
+            wanted.resize(cts);
+            fwd.resize(cts);
+            bwd.resize(cts);
+            for (size_t i = 0; i < cts; i++)
+            {
+                auto u    = layer_nodes[i];
+                wanted[i] = row[u];
+                if (!neighbors[u].empty())
+                {
+                    float sum = 0;
+                    for (auto v : neighbors[u])
+                        sum += row[v];
+                    wanted[i] = sum / neighbors[u].size();
+                }
+            }
+            for (size_t i = 0; i < cts; i++)
+                fwd[i] = i == 0 ? wanted[i] : std::max(wanted[i], fwd[i - 1] + 1);
+            for (size_t i = cts; i-- > 0;)
+                bwd[i] = i == cts - 1 ? wanted[i] : std::min(wanted[i], bwd[i + 1] - 1);
+            for (size_t i = 0; i < cts; i++)
+                row[layer_nodes[i]] = (fwd[i] + bwd[i]) * 0.5f;
+        }
+    }
+
+    float min_row = row.empty() ? 0 : *std::min_element(row.begin(), row.end());
+    for (auto& r : row)
+        r -= min_row;
+    return row;
+}
+
+std::map<uint16_t, ImVec2> layeredLayout(const std::map<uint16_t, std::vector<uint16_t>>& links)
+{
+    std::vector<uint16_t>             nums;
+    std::unordered_map<uint16_t, int> index;
+    for (const auto& [num, outs] : links)
+    {
+        index[num] = (int)nums.size();
+        nums.push_back(num);
+    }
+
+    std::vector<std::vector<int>> adj(nums.size());
+    for (const auto& [num, outs] : links)
+        for (auto out : outs)
+            if (auto iter = index.find(out); iter != index.end() && out != num)
+                adj[index[num]].push_back(iter->second);
+
+    auto graph = assignLayers(breakCycles(adj));
+    reduceCrossings(graph);
+    auto row = assignRows(graph);
+
+    std::map<uint16_t, ImVec2> result;
+    for (size_t i = 0; i < nums.size(); i++)
+        result[nums[i]] = ImVec2((float)graph.layer[i], row[i]);
+    return result;
+}
+
+const std::map<uint16_t, ImVec2>& LayoutCache::get(const std::map<uint16_t, std::vector<uint16_t>>& graph_links)
+{
+    if (graph_links != links)
+    {
+        links   = graph_links;
+        pos     = layeredLayout(links);
+        updated = true;
+    }
+    return pos;
+}
+} // namespace minskill
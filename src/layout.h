@@ -0,0 +1,19 @@
+#pragma once
+
+namespace minskill
+{
+// Sugiyama-style layered layout of a perk tree, links point from prerequisite to dependent.
+// Returns positions in grid units: x is the layer, y the row within the layer.
+std::map<uint16_t, ImVec2> layeredLayout(const std::map<uint16_t, std::vector<uint16_t>>& links);
+
+// Last layout of a config with the links it was computed from, kept in the config manifest.
+// The links themselves are the key, so a layout is only reused for the exact same graph.
+struct LayoutCache
+{
+    std::map<uint16_t, std::vector<uint16_t>> links;
+    std::map<uint16_t, ImVec2>                pos;
+    bool                                      updated = false; // since the manifest was last written
+
+    const std::map<uint16_t, ImVec2>& get(const std::map<uint16_t, std::vector<uint16_t>>& graph_links);
+};
+} // namespace minskill
@@ -1,6 +1,9 @@
 #include "cathub.h"
 #include "file.h"
 #include "hooks.h"
+#include "manifest.h"
+#include "replay.h"
+#include "skyrimgame.h"
 
 namespace minskill
 {
@@ -18,6 +21,8 @@ void draw()
         ConfigReader::getSingleton()->draw();
     }
     ImGui::End();
+
+    PerfStats::getSingleton()->draw();
 }
 
 bool integrateCatHub()
@@ -50,31 +55,81 @@ void processMessage(SKSE::MessagingInterface::Message* a_msg)
 
             if (integrateCatHub())
             {
+                auto settings = Settings::read();
+                setGame(SkyrimGame::getSingleton());
+                TraceRecorder::getSingleton()->init(settings);
                 ConfigReader::getSingleton()->readAllConfig();
+                GlobalSnapshot::getSingleton()->init(ConfigReader::getSingleton()->configs);
+                LevelUpWatcher::getSingleton()->init(ConfigReader::getSingleton()->configs);
+                LevelUpWatcher::getSingleton()->setInterval(settings.level_up_interval);
+                TraceRecorder::getSingleton()->stop();
 
                 stl::write_thunk_call<UpdateHook>();
             }
             break;
+        case SKSE::MessagingInterface::kSaveGame:
+            // the async logger's flush only queues, the writer thread does it
+            spdlog::default_logger()->flush();
+            break;
         default:
             break;
     }
 }
 } // namespace minskill
 
+constexpr size_t log_queue_size     = 8192; // preallocated messages, the oldest are dropped when full
+constexpr auto   log_flush_interval = 2s;
+
+// Drains the queue and joins the writer & flusher threads while the game still runs, joining them
+// from static destructors at DLL unload can hang. Whatever is logged after goes straight to the file.
+void shutdownLog()
+{
+    auto log  = spdlog::default_logger();
+    auto pool = spdlog::thread_pool();
+    if (auto dropped = pool->overrun_counter(); dropped > 0)
+        log->warn("{} log messages were dropped, the log queue was full.", dropped);
+
+    auto sync_log = std::make_shared<spdlog::logger>(log->name(), log->sinks().begin(), log->sinks().end());
+    sync_log->set_level(log->level());
+    sync_log->flush_on(spdlog::level::trace);
+    spdlog::set_default_logger(std::move(sync_log));
+
+    // the writer finishes the queue, flush included, before its thread ends
+    log->flush();
+    spdlog::flush_every(0s);
+    spdlog::details::registry::instance().set_tp(nullptr);
+    log.reset();
+    pool.reset();
+}
+
+namespace minskill
+{
+void onQuit()
+{
+    logger::info("Game: quitting");
+    InputRecorder::getSingleton()->finish();
+    ConfigManifest::getSingleton()->finish();
+    shutdownLog();
+}
+} // namespace minskill
+
 bool installLog()
 {
     auto path = logger::log_directory();
     if (!path)
         return false;
+    minskill::setLogDirectory(*path);
 
     *path /= fmt::format(FMT_STRING("{}.log"), SKSE::PluginDeclaration::GetSingleton()->GetName());
     auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
 
-    auto log = std::make_shared<spdlog::logger>("global log"s, std::move(sink));
+    // lines are formatted on the calling thread and written by one background thread
+    spdlog::init_thread_pool(log_queue_size, 1);
+    auto log = std::make_shared<spdlog::async_logger>("global log"s, std::move(sink), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
 
 #ifndef DBGMSG
     log->set_level(spdlog::level::info);
-    log->flush_on(spdlog::level::info);
+    log->flush_on(spdlog::level::warn);
 #else
     log->set_level(spdlog::level::trace);
     log->flush_on(spdlog::level::trace);
@@ -82,6 +137,7 @@ bool installLog()
 
     spdlog::set_default_logger(std::move(log));
     spdlog::set_pattern("[%H:%M:%S:%e][%5l] %v"s);
+    spdlog::flush_every(log_flush_interval);
 
     return true;
 }
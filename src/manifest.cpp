@@ -0,0 +1,304 @@
+#include "manifest.h"
+#include "trace.h"
+#include "utils.h"
+
+#include <fstream>
+
+namespace minskill
+{
+const auto         config_prefix    = "customskill."sv;
+const auto         config_suffix    = ".config.txt"sv;
+constexpr uint32_t manifest_magic   = 0x434B534D; // "MSKC"
+constexpr uint16_t manifest_version = 2;          // bump when the format changes or parseConfig reads a file differently
+const auto         manifest_name    = "MinimalisticSkillMenu.configs.bin"sv;
+
+// Case-insensitive match on the file name, without copying it out of the path
+template <class Char>
+static bool isConfigName(std::basic_string_view<Char> path)
+{
+    constexpr Char separators[] = {'/', '\\'};
+    if (auto sep = path.find_last_of(separators, path.npos, 2); sep != path.npos)
+        path.remove_prefix(sep + 1);
+    if (path.size() < config_prefix.size() + config_suffix.size())
+        return false;
+
+    auto equal = [](char lower, Char chr) {
+        auto code = (std::make_unsigned_t<Char>)chr;
+        return code < 128 && std::tolower((int)code) == lower;
+    };
+    return std::equal(config_prefix.begin(), config_prefix.end(), path.begin(), equal) &&
+           std::equal(config_suffix.begin(), config_suffix.end(), path.end() - config_suffix.size(), equal);
+}
+
+static void writeString(std::ofstream& out, const std::string& str)
+{
+    writeRaw(out, (uint32_t)str.size());
+    out.write(str.data(), str.size());
+}
+
+static bool readString(std::ifstream& in, std::string& str)
+{
+    uint32_t len;
+    if (!readRaw(in, len) || len > (1 << 24))
+        return false;
+    str.resize(len);
+    return (bool)in.read(str.data(), len);
+}
+
+static void writeForm(std::ofstream& out, const FormRef& form)
+{
+    writeString(out, form.plugin);
+    writeRaw(out, form.id);
+}
+
+static bool readForm(std::ifstream& in, FormRef& form)
+{
+    return readString(in, form.plugin) && readRaw(in, form.id);
+}
+
+static void writeParsed(std::ofstream& out, const ParsedConfig& parsed)
+{
+    writeString(out, parsed.name);
+    writeString(out, parsed.desc);
+    for (const auto* form : {&parsed.skill_lvl, &parsed.lvl_ratio, &parsed.show_lvl_up, &parsed.perk_pts, &parsed.legend_cts})
+        writeForm(out, *form);
+    writeRaw(out, (uint32_t)parsed.nodes.size());
+    for (const auto& node : parsed.nodes)
+    {
+        writeRaw(out, node.num);
+        writeForm(out, node.perk);
+        writeRaw(out, (uint8_t)node.has_pos);
+        writeRaw(out, node.gridx);
+        writeRaw(out, node.gridy);
+        writeRaw(out, node.x);
+        writeRaw(out, node.y);
+        writeRaw(out, (uint32_t)node.links.size());
+        out.write(reinterpret_cast<const char*>(node.links.data()), node.links.size() * sizeof(uint16_t));
+    }
+}
+
+static bool readParsed(std::ifstream& in, ParsedConfig& parsed)
+{
+    if (!readString(in, parsed.name) || !readString(in, parsed.desc))
+        return false;
+    for (auto* form : {&parsed.skill_lvl, &parsed.lvl_ratio, &parsed.show_lvl_up, &parsed.perk_pts, &parsed.legend_cts})
+        if (!readForm(in, *form))
+            return false;
+
+    uint32_t node_cts;
+    if (!readRaw(in, node_cts) || node_cts > UINT16_MAX)
+        return false;
+    parsed.nodes.resize(node_cts);
+    for (auto& node : parsed.nodes)
+    {
+        uint8_t  has_pos;
+        uint32_t link_cts;
+        if (!readRaw(in, node.num) || !readForm(in, node.perk) || !readRaw(in, has_pos) || !readRaw(in, node.gridx) || !readRaw(in, node.gridy) ||
+            !readRaw(in, node.x) || !readRaw(in, node.y) || !readRaw(in, link_cts) || link_cts > (1 << 20))
+            return false;
+        node.has_pos = has_pos != 0;
+        node.links.resize(link_cts);
+        if (!in.read(reinterpret_cast<char*>(node.links.data()), link_cts * sizeof(uint16_t)))
+            return false;
+    }
+    return true;
+}
+
+static void writeLayout(std::ofstream& out, const LayoutCache& layout)
+{
+    writeRaw(out, (uint32_t)layout.links.size());
+    for (const auto& [num, outs] : layout.links)
+    {
+        auto pos = layout.pos.at(num);
+        writeRaw(out, num);
+        writeRaw(out, pos.x);
+        writeRaw(out, pos.y);
+        writeRaw(out, (uint32_t)outs.size());
+        out.write(reinterpret_cast<const char*>(outs.data()), outs.size() * sizeof(uint16_t));
+    }
+}
+
+static bool readLayout(std::ifstream& in, LayoutCache& layout)
+{
+    uint32_t node_cts;
+    if (!readRaw(in, node_cts) || node_cts > UINT16_MAX + 1)
+        return false;
+    for (uint32_t i = 0; i < node_cts; i++)
+    {
+        uint16_t num;
+        ImVec2   pos;
+        uint32_t link_cts;
+        if (!readRaw(in, num) || !readRaw(in, pos.x) || !readRaw(in, pos.y) || !readRaw(in, link_cts) || link_cts > (1 << 20))
+            return false;
+        auto& outs = layout.links[num];
+        outs.resize(link_cts);
+        if (!in.read(reinterpret_cast<char*>(outs.data()), link_cts * sizeof(uint16_t)))
+            return false;
+        layout.pos[num] = pos;
+    }
+    return true;
+}
+
+void ConfigManifest::finish()
+{
+    if (writer.joinable())
+        writer.join();
+}
+
+void ConfigManifest::setFile(fs::path path)
+{
+    clear();
+    file = std::move(path);
+}
+
+void ConfigManifest::clear()
+{
+    finish();
+    entries.clear();
+    dir_key.clear();
+    loaded = false;
+    dirty  = false;
+}
+
+void ConfigManifest::load()
+{
+    TraceZone zone("manifest load");
+    loaded = true;
+    if (file.empty())
+    {
+        auto dir = logDirectory();
+        if (!dir)
+            return; // parsed configs are only kept in memory
+        file = *dir / manifest_name;
+    }
+
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+        return;
+
+    uint32_t magic;
+    uint16_t version;
+    uint32_t file_cts;
+    if (!readRaw(in, magic) || magic != manifest_magic || !readRaw(in, version) || version != manifest_version || !readString(in, dir_key) ||
+        !readRaw(in, file_cts))
+    {
+        logger::info("Config manifest {} is outdated or invalid, all configs are parsed again.", file.string());
+        dir_key.clear();
+        return;
+    }
+
+    for (uint32_t i = 0; i < file_cts; i++)
+    {
+        std::string name;
+        Entry       entry;
+        if (!readString(in, name) || !readRaw(in, entry.size) || !readRaw(in, entry.mtime) || !readParsed(in, entry.parsed) ||
+            !readLayout(in, entry.layout))
+        {
+            // a partly read manifest could pair a file with another's contents
+            logger::warn("Config manifest {} is truncated, all configs are parsed again.", file.string());
+            entries.clear();
+            return;
+        }
+        entries[name] = std::move(entry);
+    }
+}
+
+std::vector<ConfigManifest::ScanEntry> ConfigManifest::scan(const fs::path& dir)
+{
+    finish();
+    if (!loaded)
+        load();
+
+    TraceZone zone("manifest scan");
+    last_scan = {};
+    if (dir_key != dir.string())
+    {
+        entries.clear();
+        dir_key = dir.string();
+        dirty   = true;
+    }
+    for (auto& [name, entry] : entries)
+        entry.seen = false;
+
+    // The directory is always listed, its own modification time can't be trusted under the
+    // virtual file systems of mod managers. Listing is cheap, only configs are looked at further.
+    std::vector<ScanEntry> result;
+    std::error_code        err;
+    for (fs::directory_iterator iter(dir, err), end; !err && iter != end; iter.increment(err))
+    {
+        last_scan.entries++;
+        std::error_code stat_err;
+        if (!isConfigName(std::basic_string_view<fs::path::value_type>(iter->path().native())) || !iter->is_regular_file(stat_err))
+            continue;
+
+        last_scan.configs++;
+        auto size  = iter->file_size(stat_err);
+        auto mtime = (int64_t)iter->last_write_time(stat_err).time_since_epoch().count();
+        auto name  = iter->path().filename().string();
+        auto found = entries.find(name);
+        if (found == entries.end() || stat_err || found->second.size != size || found->second.mtime != mtime)
+        {
+            last_scan.parsed++;
+            dirty       = true;
+            auto parsed = parseConfig(iter->path());
+            if (!parsed)
+            {
+                // not kept, so the error is logged again next run
+                last_scan.failed++;
+                if (found != entries.end())
+                    entries.erase(found);
+                result.push_back({iter->path(), nullptr, nullptr});
+                continue;
+            }
+            found = entries.insert_or_assign(name, Entry{size, mtime, std::move(*parsed)}).first;
+        }
+        found->second.seen = true;
+        result.push_back({iter->path(), &found->second.parsed, &found->second.layout});
+    }
+
+    // configs removed since the last scan
+    dirty |= std::erase_if(entries, [](const auto& item) { return !item.second.seen; }) > 0;
+    return result;
+}
+
+void ConfigManifest::save()
+{
+    for (auto& [name, entry] : entries)
+        dirty |= std::exchange(entry.layout.updated, false);
+    if (!dirty || file.empty())
+        return;
+    dirty = false;
+    finish();
+
+    writer = std::jthread([path = file, dir = dir_key, snapshot = entries]() {
+        std::error_code err;
+        fs::create_directories(path.parent_path(), err);
+        auto          temp_file = fs::path(path).concat(".tmp");
+        std::ofstream out(temp_file, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            logger::warn("Failed to write config manifest {}", path.string());
+            return;
+        }
+
+        writeRaw(out, manifest_magic);
+        writeRaw(out, manifest_version);
+        writeString(out, dir);
+        writeRaw(out, (uint32_t)snapshot.size());
+        for (const auto& [name, entry] : snapshot)
+        {
+            writeString(out, name);
+            writeRaw(out, entry.size);
+            writeRaw(out, entry.mtime);
+            writeParsed(out, entry.parsed);
+            writeLayout(out, entry.layout);
+        }
+        out.close();
+
+        if (out)
+            fs::rename(temp_file, path, err);
+        if (!out || err)
+            logger::warn("Failed to write config manifest {}", path.string());
+    });
+}
+} // namespace minskill
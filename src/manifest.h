@@ -0,0 +1,67 @@
+#pragma once
+
+#include "file.h"
+
+#include <thread>
+
+namespace minskill
+{
+struct ManifestStats
+{
+    size_t entries = 0; // directory entries listed
+    size_t configs = 0;
+    size_t parsed  = 0; // new or changed since the manifest was written
+    size_t failed  = 0;
+};
+
+// Size, modification time, parsed contents and automatic layout of the config files seen
+// last run, kept in a binary file next to the log. Unchanged files are not parsed again.
+class ConfigManifest
+{
+public:
+    struct ScanEntry
+    {
+        fs::path            path;
+        const ParsedConfig* parsed; // nullptr when the file failed to parse
+        LayoutCache*        layout; // nullptr along with parsed
+    };
+
+    static ConfigManifest* getSingleton()
+    {
+        static ConfigManifest manifest;
+        return std::addressof(manifest);
+    }
+
+    // Config files of dir in directory order, valid until the next scan
+    std::vector<ScanEntry> scan(const fs::path& dir);
+    // Writes the manifest in the background if the last scan changed it
+    void save();
+    // Waits for the background write, before the plugin unloads
+    void finish();
+    // Forgets everything, the next scan reads the file again
+    void clear();
+    // Defaults to the log directory, without one the manifest is only kept in memory
+    void setFile(fs::path path);
+
+    ManifestStats last_scan;
+
+private:
+    struct Entry
+    {
+        uintmax_t    size  = 0;
+        int64_t      mtime = 0;
+        ParsedConfig parsed;
+        LayoutCache  layout;
+        bool         seen = false;
+    };
+
+    void load();
+
+    fs::path                     file;
+    std::string                  dir_key; // directory the entries belong to
+    std::map<std::string, Entry> entries; // by file name
+    bool                         loaded = false;
+    bool                         dirty  = false;
+    std::jthread                 writer;
+};
+} // namespace minskill
@@ -0,0 +1,77 @@
+#include "notify.h"
+
+namespace minskill
+{
+constexpr auto   coalesce_window = std::chrono::milliseconds(300);  // level ups merged into one message
+constexpr auto   min_flush_gap   = std::chrono::milliseconds(1500); // bursts wait for the next message
+constexpr size_t max_listed      = 4;
+
+void LevelUpWatcher::init(const std::vector<SkillConfig>& configs)
+{
+    globals.clear();
+    names.clear();
+    templates.clear();
+    for (const auto& config : configs)
+        if (config.loaded)
+        {
+            globals.push_back(config.g_show_lvl_up);
+            names.push_back(config.name);
+            templates.push_back(fmt::format("Skill \"{}\" has reached lvl. ", config.name));
+        }
+    pending.assign(globals.size(), 0);
+    pending_cts = 0;
+    logger::info("Watching level ups of {} skills.", globals.size());
+}
+
+void LevelUpWatcher::update()
+{
+    if (++frame < interval)
+        return;
+    frame = 0;
+
+    for (size_t i = 0; i < globals.size(); i++)
+        if (float val = game().getGlobal(globals[i]); val >= 0.5f) // rounds to a positive level
+        {
+            auto lvl = std::lround(val);
+            game().setGlobal(globals[i], 0);
+            if (pending_cts == 0)
+                window_start = Clock::now();
+            if (pending[i] == 0)
+                pending_cts++;
+            pending[i] = std::max(pending[i], lvl);
+        }
+
+    if (pending_cts == 0)
+        return;
+    auto now = Clock::now();
+    if (now - window_start >= coalesce_window && now - last_flush >= min_flush_gap)
+    {
+        last_flush = now;
+        flush();
+    }
+}
+
+void LevelUpWatcher::flush()
+{
+    std::string msg;
+    if (pending_cts == 1)
+    {
+        auto idx = std::find_if(pending.begin(), pending.end(), [](long lvl) { return lvl > 0; }) - pending.begin();
+        msg      = templates[idx] + std::to_string(pending[idx]);
+    }
+    else
+    {
+        msg        = fmt::format("{} skills have leveled up:", pending_cts);
+        size_t cts = 0;
+        for (size_t i = 0; i < pending.size() && cts < max_listed; i++)
+            if (pending[i] > 0)
+                msg += fmt::format("{} {} {}", cts++ ? "," : "", names[i], pending[i]);
+        if (pending_cts > max_listed)
+            msg += fmt::format(" and {} more", pending_cts - max_listed);
+    }
+    std::fill(pending.begin(), pending.end(), 0);
+    pending_cts = 0;
+
+    game().notify(std::move(msg), "UISkillIncreaseSD");
+}
+} // namespace minskill
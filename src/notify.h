@@ -0,0 +1,39 @@
+#pragma once
+
+#include "file.h"
+
+namespace minskill
+{
+// Watches the show-level-up globals of loaded configs from the game thread.
+// Level ups close together are merged into one message & sound.
+class LevelUpWatcher
+{
+public:
+    static LevelUpWatcher* getSingleton()
+    {
+        static LevelUpWatcher watcher;
+        return std::addressof(watcher);
+    }
+
+    void init(const std::vector<SkillConfig>& configs);
+    void update();
+
+    void setInterval(uint32_t frames) { interval = std::max<uint32_t>(frames, 1); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void flush();
+
+    std::vector<GlobalHandle> globals; // compact, only loaded configs
+    std::vector<std::string>  names;
+    std::vector<std::string>  templates; // single skill message without the level
+    std::vector<long>         pending;   // highest level not yet shown, 0 if none
+    size_t                    pending_cts = 0;
+
+    uint32_t          interval = 10; // frames between checks
+    uint32_t          frame    = 0;
+    Clock::time_point window_start;
+    Clock::time_point last_flush;
+};
+} // namespace minskill
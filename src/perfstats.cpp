@@ -0,0 +1,81 @@
+#include "perfstats.h"
+
+namespace minskill
+{
+constexpr std::array<const char*, (size_t)PerfZone::Total> zone_names = {"Menu", "Canvas", "Connections", "Perk Info", "Update Hook"};
+
+void PerfStats::setEnabled(bool enable)
+{
+    std::lock_guard lock(mutex);
+    if (enable && !enabled())
+        for (auto& ring : rings)
+            ring = Ring();
+    on.store(enable, std::memory_order_relaxed);
+}
+
+void PerfStats::add(PerfZone zone, float ms)
+{
+    std::lock_guard lock(mutex);
+    auto&           ring = rings[(size_t)zone];
+
+    ring.samples[ring.next] = ms;
+    ring.next               = (ring.next + 1) % ring_size;
+    ring.size               = std::min(ring.size + 1, ring_size);
+}
+
+void PerfStats::setCounts(size_t nodes, size_t curves, size_t vertices)
+{
+    std::lock_guard lock(mutex);
+    node_cts   = nodes;
+    curve_cts  = curves;
+    vertex_cts = vertices;
+}
+
+void PerfStats::draw()
+{
+    if (!enabled())
+        return;
+
+    if (ImGui::Begin("Skill Menu Performance", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        std::lock_guard lock(mutex);
+        if (ImGui::BeginTable("Timings", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter))
+        {
+            ImGui::TableSetupColumn("Section (ms)");
+            ImGui::TableSetupColumn("Min");
+            ImGui::TableSetupColumn("Avg");
+            ImGui::TableSetupColumn("P99");
+            ImGui::TableHeadersRow();
+
+            std::array<float, ring_size> sorted;
+            for (size_t i = 0; i < rings.size(); i++)
+            {
+                const auto& ring = rings[i];
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(zone_names[i]);
+                if (ring.size == 0)
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted("-");
+                    ImGui::TableNextColumn();
+                    ImGui::TableNextColumn();
+                    continue;
+                }
+
+                auto end = std::copy_n(ring.samples.begin(), ring.size, sorted.begin());
+                std::sort(sorted.begin(), end);
+                float sum = std::accumulate(sorted.begin(), end, 0.0f);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", sorted[0]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", sum / ring.size);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", sorted[std::min(ring.size - 1, ring.size * 99 / 100)]);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::Text("Nodes: %zu  Curves: %zu  Vertices: %zu", node_cts, curve_cts, vertex_cts);
+    }
+    ImGui::End();
+}
+} // namespace minskill
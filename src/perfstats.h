@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+namespace minskill
+{
+enum class PerfZone : uint8_t
+{
+    MenuDraw,
+    Canvas,
+    Connections,
+    PerkInfo,
+    UpdateHook,
+    Total
+};
+
+// Rolling per-section timings for the in-menu overlay, nothing is recorded while it is off
+class PerfStats
+{
+public:
+    static PerfStats* getSingleton()
+    {
+        static PerfStats stats;
+        return std::addressof(stats);
+    }
+
+    bool enabled() const { return on.load(std::memory_order_relaxed); }
+    void setEnabled(bool enable);
+
+    void add(PerfZone zone, float ms);
+    void setCounts(size_t nodes, size_t curves, size_t vertices);
+    void draw();
+
+private:
+    static constexpr size_t ring_size = 240;
+
+    struct Ring
+    {
+        std::array<float, ring_size> samples = {};
+        size_t                       next    = 0;
+        size_t                       size    = 0;
+    };
+
+    std::atomic<bool>                         on = false;
+    std::mutex                                mutex; // UpdateHook adds from the game thread
+    std::array<Ring, (size_t)PerfZone::Total> rings;
+    size_t                                    node_cts   = 0;
+    size_t                                    curve_cts  = 0;
+    size_t                                    vertex_cts = 0;
+};
+
+// Times the enclosing scope into PerfStats when the overlay is on
+class PerfScope
+{
+public:
+    explicit PerfScope(PerfZone zone) : zone(zone), active(PerfStats::getSingleton()->enabled())
+    {
+        if (active)
+            start = std::chrono::steady_clock::now();
+    }
+    ~PerfScope() { stop(); }
+
+    // Ends the zone before the scope does
+    void stop()
+    {
+        if (active)
+            PerfStats::getSingleton()->add(zone, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+        active = false;
+    }
+
+private:
+    PerfZone                              zone;
+    bool                                  active;
+    std::chrono::steady_clock::time_point start;
+};
+} // namespace minskill
@@ -0,0 +1,295 @@
+#include "replay.h"
+#include "commands.h"
+#include "viewstore.h"
+
+#include <fstream>
+#include "toml++/toml.h"
+
+namespace minskill
+{
+constexpr int recording_version = 1;
+
+static toml::array toArray(ImVec2 vec)
+{
+    return toml::array{vec.x, vec.y};
+}
+
+template <class T>
+static ImVec2 toVec(const toml::node_view<T>& node)
+{
+    return {node[0].value_or(0.0f), node[1].value_or(0.0f)};
+}
+
+bool writeRecording(const std::filesystem::path& path, const Recording& recording)
+{
+    toml::table tbl;
+    tbl.insert("version", recording_version);
+    tbl.insert("display", toArray(recording.display));
+    tbl.insert("ini", recording.ini);
+    tbl.insert("use_list", recording.use_list);
+    tbl.insert("shown", (int64_t)recording.shown);
+
+    // delta, mouse x & y, buttons, wheel, horizontal wheel, modifiers
+    toml::array frames;
+    for (const auto& frame : recording.frames)
+        frames.push_back(toml::array{frame.delta, frame.mouse.x, frame.mouse.y, frame.buttons, frame.wheel, frame.wheel_h, frame.mods});
+    tbl.insert("frames", std::move(frames));
+
+    toml::array configs;
+    for (const auto& config : recording.configs)
+    {
+        toml::array perks;
+        for (const auto& perk : config.perks)
+        {
+            toml::array links, ranks;
+            for (auto link : perk.links)
+                links.push_back(link);
+            for (const auto& rank : perk.ranks)
+                ranks.push_back(toml::table{{"name", rank.name},
+                                            {"desc", rank.desc},
+                                            {"skill_req", (int64_t)rank.skill_req},
+                                            {"legend_req", (int64_t)rank.legend_req},
+                                            {"other_conds", rank.other_conds},
+                                            {"conds_met", rank.conds_met}});
+            perks.push_back(toml::table{{"num", perk.num},
+                                        {"pos", toArray(perk.pos)},
+                                        {"default_pos", toArray(perk.default_pos)},
+                                        {"links", std::move(links)},
+                                        {"owned", perk.owned},
+                                        {"selected", perk.selected},
+                                        {"rank", std::move(ranks)}});
+        }
+        configs.push_back(toml::table{{"name", config.name},
+                                      {"desc", config.desc},
+                                      {"loaded", config.loaded},
+                                      {"skill_lvl", config.skill_lvl},
+                                      {"lvl_ratio", config.lvl_ratio},
+                                      {"perk_pts", config.perk_pts},
+                                      {"legend_cts", config.legend_cts},
+                                      {"has_perk_pts", config.has_perk_pts},
+                                      {"has_legend", config.has_legend},
+                                      {"zoom", config.zoom},
+                                      {"offset", toArray(config.offset)},
+                                      {"perk", std::move(perks)}});
+    }
+    tbl.insert("config", std::move(configs));
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        return false;
+    out << tbl << "\n";
+    return (bool)out;
+}
+
+std::optional<Recording> readRecording(const std::filesystem::path& path)
+{
+    toml::table tbl;
+    try
+    {
+        tbl = toml::parse_file(path.string());
+    }
+    catch (const toml::parse_error& err)
+    {
+        logger::error("Failed to parse recording {}: {}", path.string(), err.description());
+        return std::nullopt;
+    }
+    if (tbl["version"].value_or(0) != recording_version)
+    {
+        logger::error("Recording {} has an unknown version.", path.string());
+        return std::nullopt;
+    }
+
+    Recording recording;
+    recording.display  = toVec(tbl["display"]);
+    recording.ini      = tbl["ini"].value_or<std::string>("");
+    recording.use_list = tbl["use_list"].value_or(false);
+    recording.shown    = (size_t)tbl["shown"].value_or<int64_t>(0);
+
+    if (auto frames = tbl["frames"].as_array())
+        for (const auto& node : *frames)
+        {
+            toml::node_view<const toml::node> frame{&node};
+            recording.frames.push_back({frame[0].value_or(0.0f),
+                                        {frame[1].value_or(-FLT_MAX), frame[2].value_or(-FLT_MAX)},
+                                        frame[3].value_or<uint8_t>(0),
+                                        frame[4].value_or(0.0f),
+                                        frame[5].value_or(0.0f),
+                                        frame[6].value_or<uint8_t>(0)});
+        }
+
+    if (auto configs = tbl["config"].as_array())
+        for (const auto& config_node : *configs)
+        {
+            toml::node_view<const toml::node> config_tbl{&config_node};
+            auto&                             config = recording.configs.emplace_back();
+
+            config.name         = config_tbl["name"].value_or<std::string>("");
+            config.desc         = config_tbl["desc"].value_or<std::string>("");
+            config.loaded       = config_tbl["loaded"].value_or(false);
+            config.skill_lvl    = config_tbl["skill_lvl"].value_or(0.0f);
+            config.lvl_ratio    = config_tbl["lvl_ratio"].value_or(0.0f);
+            config.perk_pts     = config_tbl["perk_pts"].value_or(0.0f);
+            config.legend_cts   = config_tbl["legend_cts"].value_or(0.0f);
+            config.has_perk_pts = config_tbl["has_perk_pts"].value_or(false);
+            config.has_legend   = config_tbl["has_legend"].value_or(false);
+            config.zoom         = config_tbl["zoom"].value_or(1.0f);
+            config.offset       = toVec(config_tbl["offset"]);
+
+            if (auto perks = config_tbl["perk"].as_array())
+                for (const auto& perk_node : *perks)
+                {
+                    toml::node_view<const toml::node> perk_tbl{&perk_node};
+                    auto&                             perk = config.perks.emplace_back();
+
+                    perk.num         = perk_tbl["num"].value_or<uint16_t>(0);
+                    perk.pos         = toVec(perk_tbl["pos"]);
+                    perk.default_pos = toVec(perk_tbl["default_pos"]);
+                    perk.owned       = perk_tbl["owned"].value_or<uint8_t>(0);
+                    perk.selected    = perk_tbl["selected"].value_or(false);
+                    if (auto links = perk_tbl["links"].as_array())
+                        for (const auto& link : *links)
+                            perk.links.push_back(link.value_or<uint16_t>(0));
+                    if (auto ranks = perk_tbl["rank"].as_array())
+                        for (const auto& rank_node : *ranks)
+                        {
+                            toml::node_view<const toml::node> rank_tbl{&rank_node};
+                            perk.ranks.push_back({rank_tbl["name"].value_or<std::string>(""),
+                                                  rank_tbl["desc"].value_or<std::string>(""),
+                                                  rank_tbl["skill_req"].value_or<long>(0),
+                                                  rank_tbl["legend_req"].value_or<long>(0),
+                                                  rank_tbl["other_conds"].value_or(false),
+                                                  rank_tbl["conds_met"].value_or(true)});
+                        }
+                }
+        }
+    return recording;
+}
+
+void InputRecorder::start(const ConfigReader& reader)
+{
+    std::lock_guard lock(mutex);
+    if (active)
+        return;
+    if (writer.joinable())
+        writer.join();
+
+    current          = {};
+    current.display  = ImGui::GetIO().DisplaySize;
+    current.ini      = ImGui::SaveIniSettingsToMemory();
+    current.use_list = reader.use_list;
+    current.shown    = reader.use_list ? reader.list_selected : reader.shown_tab;
+
+    for (const auto& config : reader.configs)
+    {
+        auto& recorded = current.configs.emplace_back();
+        recorded.name   = config.name;
+        recorded.desc   = config.desc;
+        recorded.loaded = config.loaded;
+        if (!config.loaded)
+            continue;
+
+        const auto& globals   = reader.globals;
+        recorded.skill_lvl    = globals.get(config.slot, GlobalField::SkillLevel);
+        recorded.lvl_ratio    = globals.get(config.slot, GlobalField::LevelRatio);
+        recorded.perk_pts     = globals.get(config.slot, GlobalField::PerkPoints);
+        recorded.legend_cts   = globals.get(config.slot, GlobalField::LegendCount);
+        recorded.has_perk_pts = config.g_perk_pts != nullptr;
+        recorded.has_legend   = config.g_legend_cts != nullptr;
+        // the canvas is restored from the saved view when the tree is first shown
+        if (auto view = ViewStore::getSingleton()->find(config.path.string()))
+        {
+            recorded.zoom   = view->zoom;
+            recorded.offset = view->offset;
+        }
+
+        for (const auto& [num, perk_info] : config.perks)
+        {
+            auto& perk       = recorded.perks.emplace_back();
+            perk.num         = num;
+            perk.pos         = perk_info.pos;
+            perk.default_pos = perk_info.default_pos;
+            perk.links       = perk_info.links;
+            perk.owned       = perk_info.owned;
+            perk.selected    = perk_info.selected;
+            for (const auto& rank : perk_info.ranks)
+                perk.ranks.push_back({rank.name, rank.desc, rank.skill_req, rank.legend_req, rank.other_conds});
+        }
+
+        // conditions are only checked on the game thread, the answer fills in conds_met later
+        if (!CommandQueue::getSingleton()->send({CommandKind::CheckConditions, config.slot}))
+            logger::warn("Recording {} without perk conditions, too many pending actions.", config.name);
+    }
+
+    active = true;
+    logger::info("Recording menu input.");
+}
+
+void InputRecorder::stop()
+{
+    std::lock_guard lock(mutex);
+    writeCurrent();
+}
+
+void InputRecorder::writeCurrent()
+{
+    if (!active)
+        return;
+    active = false;
+
+    auto path = logDirectory();
+    if (!path)
+        return;
+    *path /= "MinimalisticSkillMenu.replay.toml";
+    writer = std::jthread([path = *path, recording = std::move(current)]() {
+        if (writeRecording(path, recording))
+            logger::info("Wrote {} frames of menu input to {}", recording.frames.size(), path.string());
+        else
+            logger::warn("Failed to write recording {}", path.string());
+    });
+    current = {};
+}
+
+void InputRecorder::onConditions(const CommandResult& result)
+{
+    std::lock_guard lock(mutex);
+    if (!active || result.slot >= current.configs.size())
+        return;
+    size_t i = 0;
+    for (auto& perk : current.configs[result.slot].perks)
+        for (auto& rank : perk.ranks)
+            if (i < result.conds_met.size())
+                rank.conds_met = result.conds_met[i++];
+}
+
+void InputRecorder::finish()
+{
+    std::lock_guard lock(mutex);
+    writeCurrent();
+    if (writer.joinable())
+        writer.join();
+}
+
+void InputRecorder::capture()
+{
+    if (!active)
+        return;
+    std::lock_guard lock(mutex);
+    if (!active)
+        return; // finished by the game thread meanwhile
+
+    const auto& io = ImGui::GetIO();
+    InputFrame  frame;
+    frame.delta   = io.DeltaTime;
+    frame.mouse   = io.MousePos;
+    frame.wheel   = io.MouseWheel;
+    frame.wheel_h = io.MouseWheelH;
+    for (int i = 0; i < 5; i++)
+        if (io.MouseDown[i])
+            frame.buttons |= 1 << i;
+    frame.mods = (io.KeyCtrl ? InputMod_Ctrl : 0) | (io.KeyShift ? InputMod_Shift : 0) | (io.KeyAlt ? InputMod_Alt : 0) | (io.KeySuper ? InputMod_Super : 0);
+    current.frames.push_back(frame);
+
+    if (current.frames.size() >= max_frames)
+        writeCurrent();
+}
+} // namespace minskill
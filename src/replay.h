@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace minskill
+{
+class ConfigReader;
+struct CommandResult;
+
+enum InputMod : uint8_t
+{
+    InputMod_Ctrl  = 1 << 0,
+    InputMod_Shift = 1 << 1,
+    InputMod_Alt   = 1 << 2,
+    InputMod_Super = 1 << 3,
+};
+
+// ImGui input of one menu frame
+struct InputFrame
+{
+    float   delta   = 0;
+    ImVec2  mouse   = {-FLT_MAX, -FLT_MAX};
+    uint8_t buttons = 0; // bit per mouse button
+    float   wheel   = 0;
+    float   wheel_h = 0;
+    uint8_t mods    = 0; // InputMod bits
+};
+
+struct RecordedRank
+{
+    std::string name;
+    std::string desc;
+    long        skill_req   = 0;
+    long        legend_req  = 0;
+    bool        other_conds = false;
+    bool        conds_met   = true;
+};
+
+struct RecordedPerk
+{
+    uint16_t                  num = 0;
+    ImVec2                    pos;
+    ImVec2                    default_pos;
+    std::vector<uint16_t>     links;
+    uint8_t                   owned    = 0;
+    bool                      selected = false;
+    std::vector<RecordedRank> ranks;
+};
+
+// Game state behind one skill tree, enough to rebuild it on a stub game
+struct RecordedConfig
+{
+    std::string               name;
+    std::string               desc;
+    bool                      loaded       = false;
+    float                     skill_lvl    = 0;
+    float                     lvl_ratio    = 0;
+    float                     perk_pts     = 0;
+    float                     legend_cts   = 0;
+    bool                      has_perk_pts = false; // perk points from a global rather than the player
+    bool                      has_legend   = false;
+    float                     zoom         = 1.0f;
+    ImVec2                    offset;
+    std::vector<RecordedPerk> perks;
+};
+
+// Menu state when the recording started, followed by the input of every frame
+struct Recording
+{
+    ImVec2                      display;
+    std::string                 ini; // window placement
+    bool                        use_list = false;
+    size_t                      shown    = 0; // config tab or list entry in view
+    std::vector<RecordedConfig> configs;
+    std::vector<InputFrame>     frames;
+};
+
+bool                     writeRecording(const std::filesystem::path& path, const Recording& recording);
+std::optional<Recording> readRecording(const std::filesystem::path& path);
+
+// Records menu input for replaying interactions against the benchmarks' headless canvas
+class InputRecorder
+{
+public:
+    static InputRecorder* getSingleton()
+    {
+        static InputRecorder recorder;
+        return std::addressof(recorder);
+    }
+
+    bool recording() const { return active.load(std::memory_order_relaxed); }
+    void start(const ConfigReader& reader);
+    // Writes the recording in the background
+    void stop();
+    // Stops and waits until the recording is written, before the plugin unloads
+    void finish();
+    // Perk conditions the game thread checked for the recording
+    void onConditions(const CommandResult& result);
+    // Start of each menu draw
+    void capture();
+
+private:
+    static constexpr size_t max_frames = 60 * 60 * 10; // stops by itself after about ten minutes
+
+    // Stops and writes the recording in the background, the caller holds mutex
+    void writeCurrent();
+
+    // The menu records on the render thread, finish comes from the game thread
+    std::atomic<bool> active = false;
+    std::mutex        mutex; // current, writer
+    Recording         current;
+    std::jthread      writer;
+};
+} // namespace minskill
@@ -0,0 +1,119 @@
+#include "search.h"
+
+namespace minskill
+{
+std::string toLower(std::string_view str)
+{
+    std::string result(str);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return (char)::tolower(c); });
+    return result;
+}
+
+uint32_t PerkSearchIndex::gramKey(std::string_view gram)
+{
+    uint32_t key = (uint32_t)gram.size() << 24;
+    for (size_t i = 0; i < gram.size(); i++)
+        key |= (uint32_t)(unsigned char)gram[i] << (8 * i);
+    return key;
+}
+
+void PerkSearchIndex::indexString(Postings& postings, uint32_t entry_id, std::string_view str)
+{
+    for (size_t len = 1; len <= 3; len++)
+        for (size_t i = 0; i + len <= str.size(); i++)
+        {
+            auto& list = postings[gramKey(str.substr(i, len))];
+            // entries are added in order, so a repeated gram only needs checking against the back
+            if (list.empty() || list.back() != entry_id)
+                list.push_back(entry_id);
+        }
+}
+
+void PerkSearchIndex::clear()
+{
+    entries.clear();
+    name_grams.clear();
+    desc_grams.clear();
+}
+
+void PerkSearchIndex::add(uint16_t config, uint16_t node, std::string_view label, std::string_view name, std::string_view desc)
+{
+    auto  entry_id = (uint32_t)entries.size();
+    auto& entry    = entries.emplace_back(Entry{config, node, std::string(label), toLower(name), toLower(desc)});
+    indexString(name_grams, entry_id, entry.name);
+    indexString(desc_grams, entry_id, entry.desc);
+}
+
+void PerkSearchIndex::finalize()
+{
+    for (auto& [key, list] : name_grams)
+        list.shrink_to_fit();
+    for (auto& [key, list] : desc_grams)
+        list.shrink_to_fit();
+}
+
+void PerkSearchIndex::queryField(const Postings& postings, std::string_view text, bool is_desc, std::vector<uint32_t>& out) const
+{
+    if (text.size() <= 3)
+    {
+        // the query is a gram itself, the posting list is the exact answer
+        if (auto iter = postings.find(gramKey(text)); iter != postings.end())
+            out.insert(out.end(), iter->second.begin(), iter->second.end());
+        return;
+    }
+
+    // intersect trigram postings, starting from the rarest
+    std::vector<const std::vector<uint32_t>*> lists;
+    for (size_t i = 0; i + 3 <= text.size(); i++)
+    {
+        auto iter = postings.find(gramKey(text.substr(i, 3)));
+        if (iter == postings.end())
+            return;
+        lists.push_back(&iter->second);
+    }
+    std::sort(lists.begin(), lists.end(), [](auto a, auto b) { return a->size() < b->size(); });
+
+    std::vector<uint32_t> candidates = *lists.front();
+    std::vector<uint32_t> temp;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); i++)
+    {
+        temp.clear();
+        std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(temp));
+        candidates.swap(temp);
+    }
+
+    // trigrams only narrow it down, confirm the actual substring
+    for (auto id : candidates)
+    {
+        const auto& str = is_desc ? entries[id].desc : entries[id].name;
+        if (str.find(text) != std::string::npos)
+            out.push_back(id);
+    }
+}
+
+void PerkSearchIndex::query(std::string_view text, bool with_desc, size_t max_results, std::vector<SearchHit>& results) const
+{
+    results.clear();
+    if (text.empty())
+        return;
+
+    auto                  lower = toLower(text);
+    std::vector<uint32_t> ids;
+    queryField(name_grams, lower, false, ids);
+    if (with_desc)
+    {
+        auto name_cts = ids.size();
+        queryField(desc_grams, lower, true, ids);
+        std::inplace_merge(ids.begin(), ids.begin() + name_cts, ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    for (auto id : ids)
+    {
+        if (results.size() >= max_results)
+            break;
+        const auto& entry = entries[id];
+        results.push_back({entry.config, entry.node, entry.label});
+    }
+}
+} // namespace minskill
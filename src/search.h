@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string_view>
+#include <unordered_map>
+
+namespace minskill
+{
+struct SearchHit
+{
+    uint16_t    config;
+    uint16_t    node;
+    std::string label;
+};
+
+// n-gram (1 to 3 chars) index over perk names and descriptions, built once after loading
+class PerkSearchIndex
+{
+public:
+    void clear();
+    void add(uint16_t config, uint16_t node, std::string_view label, std::string_view name, std::string_view desc);
+    void finalize();
+
+    void query(std::string_view text, bool with_desc, size_t max_results, std::vector<SearchHit>& results) const;
+
+    size_t size() const { return entries.size(); }
+
+private:
+    struct Entry
+    {
+        uint16_t    config;
+        uint16_t    node;
+        std::string label;
+        std::string name; // lowercased, all ranks
+        std::string desc; // lowercased, all ranks
+    };
+
+    using Postings = std::unordered_map<uint32_t, std::vector<uint32_t>>;
+
+    static uint32_t gramKey(std::string_view gram);
+    static void     indexString(Postings& postings, uint32_t entry_id, std::string_view str);
+    void            queryField(const Postings& postings, std::string_view text, bool is_desc, std::vector<uint32_t>& out) const;
+
+    std::vector<Entry> entries;
+    Postings           name_grams;
+    Postings           desc_grams;
+};
+
+std::string toLower(std::string_view str);
+} // namespace minskill
@@ -0,0 +1,24 @@
+#include "settings.h"
+
+#include "toml++/toml.h"
+
+namespace minskill
+{
+Settings Settings::read(const std::filesystem::path& path)
+{
+    Settings settings;
+    if (!std::filesystem::exists(path))
+        return settings;
+    try
+    {
+        auto tbl                   = toml::parse_file(path.string());
+        settings.trace_load        = tbl["Debug"]["TraceLoad"].value_or(settings.trace_load);
+        settings.level_up_interval = (uint32_t)std::clamp<int64_t>(tbl["Notify"]["LevelUpInterval"].value_or((int64_t)settings.level_up_interval), 1, 600);
+    }
+    catch (const toml::parse_error& err)
+    {
+        logger::warn("Failed to parse {}: {}", path.string(), err.description());
+    }
+    return settings;
+}
+} // namespace minskill
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace minskill
+{
+// Optional plugin settings from data/SKSE/Plugins/MinimalisticSkillMenu.toml,
+// anything missing keeps its default
+struct Settings
+{
+    bool     trace_load        = false; // [Debug] TraceLoad, records a trace of config loading
+    uint32_t level_up_interval = 10;    // [Notify] LevelUpInterval, frames between level-up checks
+
+    static Settings read(const std::filesystem::path& path = "data/SKSE/Plugins/MinimalisticSkillMenu.toml");
+};
+} // namespace minskill
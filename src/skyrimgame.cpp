@@ -0,0 +1,156 @@
+#include "skyrimgame.h"
+
+namespace minskill
+{
+union ConditionParam
+{
+    char         c;
+    std::int32_t i;
+    float        f;
+    RE::TESForm* form;
+};
+
+template <class T>
+T* getForm(const std::string& plugin_name, RE::FormID form_id, Diagnostics* diag)
+{
+    auto data_man = RE::TESDataHandler::GetSingleton();
+    auto result   = data_man->LookupForm(form_id, plugin_name);
+    if (!result)
+    {
+        if (diag)
+            diag->report(DiagKind::MissingForm, plugin_name, form_id);
+        else
+            logger::error("Failed to find form {:x} in {}", form_id, plugin_name);
+        return nullptr;
+    }
+    if (result->formType != T::FORMTYPE)
+    {
+        if (diag)
+            diag->report(DiagKind::WrongFormType, plugin_name, form_id);
+        else
+            logger::error("Form {:x} in {} doesn't match the required type!", form_id, plugin_name);
+        return nullptr;
+    }
+    return result->As<T>();
+}
+
+static RE::TESGlobal* asGlobal(GlobalHandle global)
+{
+    return static_cast<RE::TESGlobal*>(global);
+}
+
+static RE::BGSPerk* asPerk(PerkHandle perk)
+{
+    return static_cast<RE::BGSPerk*>(perk);
+}
+
+GlobalHandle SkyrimGame::findGlobal(const std::string& plugin, uint32_t form_id, Diagnostics* diag)
+{
+    return getForm<RE::TESGlobal>(plugin, form_id, diag);
+}
+
+PerkHandle SkyrimGame::findPerk(const std::string& plugin, uint32_t form_id, Diagnostics* diag)
+{
+    return getForm<RE::BGSPerk>(plugin, form_id, diag);
+}
+
+float SkyrimGame::getGlobal(GlobalHandle global)
+{
+    return asGlobal(global)->value;
+}
+
+void SkyrimGame::setGlobal(GlobalHandle global, float val)
+{
+    asGlobal(global)->value = val;
+}
+
+PerkHandle SkyrimGame::nextRank(PerkHandle perk)
+{
+    return asPerk(perk)->nextPerk;
+}
+
+std::string SkyrimGame::perkName(PerkHandle perk)
+{
+    return asPerk(perk)->GetName();
+}
+
+std::string SkyrimGame::perkDescription(PerkHandle perk)
+{
+    RE::BSString perk_desc = "";
+    asPerk(perk)->GetDescription(perk_desc, asPerk(perk));
+    return perk_desc.c_str();
+}
+
+PerkRequirements SkyrimGame::requirements(PerkHandle perk, GlobalHandle skill_lvl, GlobalHandle legend_cts)
+{
+    PerkRequirements reqs;
+    for (auto conditem = asPerk(perk)->perkConditions.head; conditem; conditem = conditem->next)
+    {
+        bool known = false;
+        if ((conditem->data.functionData.function == RE::FUNCTION_DATA::FunctionID::kGetGlobalValue) &&
+            ((conditem->data.flags.opCode == RE::CONDITION_ITEM_DATA::OpCode::kGreaterThanOrEqualTo) ||
+             (conditem->data.flags.opCode == RE::CONDITION_ITEM_DATA::OpCode::kEqualTo)))
+        {
+            auto param = std::bit_cast<ConditionParam>(conditem->data.functionData.params[0]).form;
+            if ((uintptr_t)param == (uintptr_t)skill_lvl)
+            {
+                reqs.skill_req = std::lround(conditem->data.comparisonValue.f);
+                known          = true;
+            }
+            else if (legend_cts && (uintptr_t)param == (uintptr_t)legend_cts)
+            {
+                reqs.legend_req = std::lround(conditem->data.comparisonValue.f);
+                known           = true;
+            }
+        }
+        reqs.other_conds |= !known;
+    }
+    return reqs;
+}
+
+bool SkyrimGame::conditionsMet(PerkHandle perk)
+{
+    return asPerk(perk)->perkConditions.IsTrue(RE::PlayerCharacter::GetSingleton(), nullptr);
+}
+
+bool SkyrimGame::hasPerk(PerkHandle perk)
+{
+    return RE::PlayerCharacter::GetSingleton()->HasPerk(asPerk(perk));
+}
+
+void SkyrimGame::addPerk(PerkHandle perk)
+{
+    RE::PlayerCharacter::GetSingleton()->AddPerk(asPerk(perk));
+}
+
+void SkyrimGame::removePerk(PerkHandle perk)
+{
+    RE::PlayerCharacter::GetSingleton()->RemovePerk(asPerk(perk));
+}
+
+long SkyrimGame::perkPoints()
+{
+    return RE::PlayerCharacter::GetSingleton()->GetGameStatsData().perkCount;
+}
+
+void SkyrimGame::setPerkPoints(long points)
+{
+    auto& stats     = RE::PlayerCharacter::GetSingleton()->GetGameStatsData();
+    using Count     = decltype(stats.perkCount);
+    stats.perkCount = (Count)std::clamp<long>(points, std::numeric_limits<Count>::min(), std::numeric_limits<Count>::max());
+}
+
+void SkyrimGame::playSound(const char* sound)
+{
+    RE::PlaySound(sound);
+}
+
+void SkyrimGame::notify(std::string msg, const char* sound)
+{
+    // UI calls go to the task queue, out of RE::Main::Update
+    SKSE::GetTaskInterface()->AddTask([msg = std::move(msg), sound]() {
+        RE::DebugNotification(msg.c_str());
+        RE::PlaySound(sound);
+    });
+}
+} // namespace minskill
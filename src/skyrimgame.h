@@ -0,0 +1,37 @@
+#pragma once
+
+#include "game.h"
+
+namespace minskill
+{
+class SkyrimGame : public GameInterface
+{
+public:
+    static SkyrimGame* getSingleton()
+    {
+        static SkyrimGame skyrim;
+        return std::addressof(skyrim);
+    }
+
+    GlobalHandle findGlobal(const std::string& plugin, uint32_t form_id, Diagnostics* diag) override;
+    PerkHandle   findPerk(const std::string& plugin, uint32_t form_id, Diagnostics* diag) override;
+
+    float getGlobal(GlobalHandle global) override;
+    void  setGlobal(GlobalHandle global, float val) override;
+
+    PerkHandle       nextRank(PerkHandle perk) override;
+    std::string      perkName(PerkHandle perk) override;
+    std::string      perkDescription(PerkHandle perk) override;
+    PerkRequirements requirements(PerkHandle perk, GlobalHandle skill_lvl, GlobalHandle legend_cts) override;
+
+    bool conditionsMet(PerkHandle perk) override;
+    bool hasPerk(PerkHandle perk) override;
+    void addPerk(PerkHandle perk) override;
+    void removePerk(PerkHandle perk) override;
+    long perkPoints() override;
+    void setPerkPoints(long points) override;
+
+    void playSound(const char* sound) override;
+    void notify(std::string msg, const char* sound) override;
+};
+} // namespace minskill
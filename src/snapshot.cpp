@@ -0,0 +1,86 @@
+#include "snapshot.h"
+#include "file.h"
+
+namespace minskill
+{
+void GlobalSnapshot::init(const std::vector<SkillConfig>& configs)
+{
+    sources.clear();
+    for (const auto& config : configs)
+    {
+        if (!config.loaded)
+        {
+            sources.insert(sources.end(), global_fields, Source{nullptr, false});
+            continue;
+        }
+        sources.push_back({config.g_skill_lvl, false});
+        sources.push_back({config.g_lvl_ratio, false});
+        sources.push_back({config.g_perk_pts, !config.g_perk_pts});
+        sources.push_back({config.g_legend_cts, false});
+    }
+    last.assign(sources.size(), 0.0f);
+    shared = std::make_unique<std::atomic<float>[]>(sources.size());
+    sample();
+}
+
+void GlobalSnapshot::sample()
+{
+    bool  dirty     = false;
+    float stats_pts = (float)game().perkPoints();
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        const auto& source = sources[i];
+        float       val    = source.global ? game().getGlobal(source.global) : source.from_stats ? stats_pts : 0.0f;
+        if (val != last[i])
+        {
+            last[i] = val;
+            dirty   = true;
+        }
+    }
+    if (!dirty && seq.load(std::memory_order_relaxed) != 0)
+        return;
+
+    auto curr = seq.load(std::memory_order_relaxed);
+    seq.store(curr + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < last.size(); i++)
+        shared[i].store(last[i], std::memory_order_relaxed);
+    seq.store(curr + 2, std::memory_order_release);
+}
+
+bool GlobalSnapshot::read(GlobalValues& out) const
+{
+    out.any_changed = false;
+    auto curr       = seq.load(std::memory_order_acquire);
+    if (curr == out.seq && out.values.size() == sources.size())
+    {
+        std::fill(out.changed.begin(), out.changed.end(), false);
+        return false;
+    }
+
+    std::vector<float> next(sources.size());
+    for (;;)
+    {
+        curr = seq.load(std::memory_order_acquire);
+        if (curr & 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < next.size(); i++)
+            next[i] = shared[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == curr)
+            break;
+    }
+
+    out.changed.assign(next.size(), true);
+    if (out.values.size() == next.size())
+        for (size_t i = 0; i < next.size(); i++)
+            out.changed[i] = next[i] != out.values[i];
+    out.any_changed = std::find(out.changed.begin(), out.changed.end(), true) != out.changed.end();
+    out.values.swap(next);
+    out.seq = curr;
+    return true;
+}
+} // namespace minskill
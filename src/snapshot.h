@@ -0,0 +1,71 @@
+#pragma once
+
+#include "game.h"
+
+#include <atomic>
+
+namespace minskill
+{
+struct SkillConfig;
+
+enum class GlobalField : uint8_t
+{
+    SkillLevel,
+    LevelRatio,
+    PerkPoints,
+    LegendCount,
+    Total
+};
+
+constexpr size_t global_fields = (size_t)GlobalField::Total;
+
+// Copy of all watched globals owned by one reader
+struct GlobalValues
+{
+    std::vector<float> values;  // slot * global_fields + field
+    std::vector<bool>  changed; // since the reader's previous copy
+    bool               any_changed = false;
+    uint64_t           seq         = 0;
+
+    float get(size_t slot, GlobalField field) const
+    {
+        auto i = slot * global_fields + (size_t)field;
+        return i < values.size() ? values[i] : 0.0f;
+    }
+    bool hasChanged(size_t slot, GlobalField field) const
+    {
+        auto i = slot * global_fields + (size_t)field;
+        return i < changed.size() && changed[i];
+    }
+};
+
+// Globals of all configs sampled once per update on the game thread and published with a seqlock,
+// so the UI gets a consistent copy without locking
+class GlobalSnapshot
+{
+public:
+    static GlobalSnapshot* getSingleton()
+    {
+        static GlobalSnapshot snapshot;
+        return std::addressof(snapshot);
+    }
+
+    // before the update hook is installed, config index is the slot
+    void init(const std::vector<SkillConfig>& configs);
+    void sample();
+    // false if nothing was published since the last read
+    bool read(GlobalValues& out) const;
+
+private:
+    struct Source
+    {
+        GlobalHandle global;
+        bool         from_stats; // perk points without a global
+    };
+
+    std::vector<Source>                   sources;
+    std::vector<float>                    last;
+    std::unique_ptr<std::atomic<float>[]> shared;
+    std::atomic<uint64_t>                 seq = 0;
+};
+} // namespace minskill
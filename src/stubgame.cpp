@@ -0,0 +1,132 @@
+#include "stubgame.h"
+
+namespace minskill
+{
+GlobalHandle StubGame::addGlobal(const std::string& plugin, uint32_t form_id, float value)
+{
+    auto& global             = globals.emplace_back(StubGlobal{value});
+    forms[{plugin, form_id}] = {false, &global};
+    return &global;
+}
+
+PerkHandle StubGame::addPerk(const std::string& plugin, uint32_t form_id, std::string name, PerkRequirements reqs, PerkHandle prev_rank)
+{
+    auto& stub_perk = perks.emplace_back();
+    stub_perk.name  = std::move(name);
+    stub_perk.desc  = fmt::format("Description of {}.", stub_perk.name);
+    stub_perk.reqs  = reqs;
+    if (prev_rank)
+        perk(prev_rank)->next = &stub_perk;
+    forms[{plugin, form_id}] = {true, &stub_perk};
+    return &stub_perk;
+}
+
+void StubGame::clear()
+{
+    globals.clear();
+    perks.clear();
+    forms.clear();
+    perk_pts      = 0;
+    sounds_played = 0;
+    notifications = 0;
+}
+
+template <class T>
+T* StubGame::find(const std::string& plugin, uint32_t form_id, bool is_perk, Diagnostics* diag)
+{
+    auto iter = forms.find({plugin, form_id});
+    if (iter == forms.end())
+    {
+        if (diag)
+            diag->report(DiagKind::MissingForm, plugin, form_id);
+        return nullptr;
+    }
+    if (iter->second.is_perk != is_perk)
+    {
+        if (diag)
+            diag->report(DiagKind::WrongFormType, plugin, form_id);
+        return nullptr;
+    }
+    return static_cast<T*>(iter->second.form);
+}
+
+GlobalHandle StubGame::findGlobal(const std::string& plugin, uint32_t form_id, Diagnostics* diag)
+{
+    return find<StubGlobal>(plugin, form_id, false, diag);
+}
+
+PerkHandle StubGame::findPerk(const std::string& plugin, uint32_t form_id, Diagnostics* diag)
+{
+    return find<StubPerk>(plugin, form_id, true, diag);
+}
+
+float StubGame::getGlobal(GlobalHandle global)
+{
+    return static_cast<StubGlobal*>(global)->value;
+}
+
+void StubGame::setGlobal(GlobalHandle global, float val)
+{
+    static_cast<StubGlobal*>(global)->value = val;
+}
+
+PerkHandle StubGame::nextRank(PerkHandle stub_perk)
+{
+    return perk(stub_perk)->next;
+}
+
+std::string StubGame::perkName(PerkHandle stub_perk)
+{
+    return perk(stub_perk)->name;
+}
+
+std::string StubGame::perkDescription(PerkHandle stub_perk)
+{
+    return perk(stub_perk)->desc;
+}
+
+PerkRequirements StubGame::requirements(PerkHandle stub_perk, GlobalHandle, GlobalHandle)
+{
+    return perk(stub_perk)->reqs;
+}
+
+bool StubGame::conditionsMet(PerkHandle stub_perk)
+{
+    return perk(stub_perk)->conds_met;
+}
+
+bool StubGame::hasPerk(PerkHandle stub_perk)
+{
+    return perk(stub_perk)->owned;
+}
+
+void StubGame::addPerk(PerkHandle stub_perk)
+{
+    perk(stub_perk)->owned = true;
+}
+
+void StubGame::removePerk(PerkHandle stub_perk)
+{
+    perk(stub_perk)->owned = false;
+}
+
+long StubGame::perkPoints()
+{
+    return perk_pts;
+}
+
+void StubGame::setPerkPoints(long points)
+{
+    perk_pts = points;
+}
+
+void StubGame::playSound(const char*)
+{
+    sounds_played++;
+}
+
+void StubGame::notify(std::string, const char*)
+{
+    notifications++;
+}
+} // namespace minskill
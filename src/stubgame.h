@@ -0,0 +1,73 @@
+#pragma once
+
+#include "game.h"
+
+#include <deque>
+
+namespace minskill
+{
+// In-memory form database and player, for running the menu logic without the game
+class StubGame : public GameInterface
+{
+public:
+    struct StubGlobal
+    {
+        float value = 0;
+    };
+
+    struct StubPerk
+    {
+        std::string      name;
+        std::string      desc;
+        StubPerk*        next = nullptr;
+        PerkRequirements reqs;
+        bool             conds_met = true; // result of conditions other than the requirements
+        bool             owned     = false;
+    };
+
+    GlobalHandle addGlobal(const std::string& plugin, uint32_t form_id, float value = 0);
+    // Chains onto prev_rank when given
+    PerkHandle addPerk(const std::string& plugin, uint32_t form_id, std::string name, PerkRequirements reqs = {}, PerkHandle prev_rank = nullptr);
+    StubPerk*  perk(PerkHandle perk) { return static_cast<StubPerk*>(perk); }
+    void       clear();
+
+    size_t sounds_played = 0;
+    size_t notifications = 0;
+
+    GlobalHandle findGlobal(const std::string& plugin, uint32_t form_id, Diagnostics* diag) override;
+    PerkHandle   findPerk(const std::string& plugin, uint32_t form_id, Diagnostics* diag) override;
+
+    float getGlobal(GlobalHandle global) override;
+    void  setGlobal(GlobalHandle global, float val) override;
+
+    PerkHandle       nextRank(PerkHandle perk) override;
+    std::string      perkName(PerkHandle perk) override;
+    std::string      perkDescription(PerkHandle perk) override;
+    PerkRequirements requirements(PerkHandle perk, GlobalHandle skill_lvl, GlobalHandle legend_cts) override;
+
+    bool conditionsMet(PerkHandle perk) override;
+    bool hasPerk(PerkHandle perk) override;
+    void addPerk(PerkHandle perk) override;
+    void removePerk(PerkHandle perk) override;
+    long perkPoints() override;
+    void setPerkPoints(long points) override;
+
+    void playSound(const char* sound) override;
+    void notify(std::string msg, const char* sound) override;
+
+private:
+    struct FormEntry
+    {
+        bool  is_perk;
+        void* form;
+    };
+
+    template <class T>
+    T* find(const std::string& plugin, uint32_t form_id, bool is_perk, Diagnostics* diag);
+
+    std::deque<StubGlobal>                                 globals;
+    std::deque<StubPerk>                                   perks;
+    std::map<std::pair<std::string, uint32_t>, FormEntry> forms;
+    long                                                   perk_pts = 0;
+};
+} // namespace minskill
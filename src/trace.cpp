@@ -0,0 +1,149 @@
+#include "trace.h"
+#include "game.h"
+
+#include <fstream>
+
+namespace minskill
+{
+constexpr auto write_delay = 100ms; // lets zones open at stop time finish
+
+TraceRecorder::~TraceRecorder()
+{
+    if (writer.joinable())
+        writer.join();
+}
+
+void TraceRecorder::init(const Settings& settings)
+{
+    if (settings.trace_load)
+    {
+        logger::info("Recording a trace of config loading.");
+        start();
+    }
+}
+
+// start and stop come from different threads, so writer is only touched under the mutex.
+// Joins happen outside it, the writer takes the mutex itself.
+void TraceRecorder::start(std::chrono::milliseconds window)
+{
+    std::jthread finished;
+    {
+        std::lock_guard lock(mutex);
+        if (recording())
+            return;
+        finished = std::move(writer);
+    }
+    if (finished.joinable())
+        finished.join();
+    epoch    = std::chrono::steady_clock::now();
+    deadline = window.count() > 0 ? epoch + window : std::chrono::steady_clock::time_point::max();
+    session.fetch_add(1, std::memory_order_relaxed);
+    active.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::stop(bool save)
+{
+    std::jthread    previous; // joined after the lock is released
+    std::lock_guard lock(mutex);
+    if (!active.exchange(false) || !save)
+        return;
+    auto curr = session.load(std::memory_order_relaxed);
+    previous  = std::move(writer);
+    writer    = std::jthread([this, curr]() {
+        std::this_thread::sleep_for(write_delay);
+        write(curr);
+    });
+}
+
+void TraceRecorder::update()
+{
+    if (recording() && std::chrono::steady_clock::now() >= deadline)
+        stop();
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::threadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard lock(mutex);
+        buffer      = buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+        buffer->tid = (uint32_t)buffers.size();
+    }
+    return buffer;
+}
+
+void TraceRecorder::record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    auto buffer = threadBuffer();
+    auto curr   = session.load(std::memory_order_relaxed);
+    if (buffer->session.load(std::memory_order_relaxed) != curr)
+    {
+        // first event of this recording, only this thread writes its buffer. The count is reset
+        // before the session is published, so readers never pair the new session with old events.
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->session.store(curr, std::memory_order_release);
+    }
+
+    auto cts = buffer->count.load(std::memory_order_relaxed);
+    if (cts >= buffer_size)
+        return;
+    buffer->events[cts] = {name,
+                           std::chrono::duration_cast<std::chrono::microseconds>(start - epoch).count(),
+                           std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()};
+    buffer->count.store(cts + 1, std::memory_order_release);
+}
+
+std::map<std::string_view, TraceRecorder::ZoneTotal> TraceRecorder::totals()
+{
+    std::map<std::string_view, ZoneTotal> result;
+    auto                                  curr = session.load(std::memory_order_relaxed);
+    std::lock_guard                       lock(mutex);
+    for (const auto& buffer : buffers)
+    {
+        if (buffer->session.load(std::memory_order_acquire) != curr)
+            continue;
+        auto cts = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < cts; i++)
+        {
+            auto& total = result[buffer->events[i].name];
+            total.count++;
+            total.total_us += buffer->events[i].dur_us;
+        }
+    }
+    return result;
+}
+
+void TraceRecorder::write(uint32_t curr)
+{
+    auto path = logDirectory();
+    if (!path)
+        return;
+    *path /= "MinimalisticSkillMenu.trace.json";
+
+    std::ofstream out(*path, std::ios::trunc);
+    if (!out)
+    {
+        logger::warn("Failed to write trace {}", path->string());
+        return;
+    }
+
+    size_t total = 0;
+    out << "{\"traceEvents\":[";
+    std::lock_guard lock(mutex);
+    for (const auto& buffer : buffers)
+    {
+        if (buffer->session.load(std::memory_order_acquire) != curr)
+            continue;
+        auto cts = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < cts; i++)
+        {
+            const auto& event = buffer->events[i];
+            out << (total++ ? ",\n" : "\n")
+                << fmt::format(R"({{"name":"{}","ph":"X","ts":{},"dur":{},"pid":1,"tid":{}}})", event.name, event.start_us, event.dur_us, buffer->tid);
+        }
+    }
+    out << "\n]}\n";
+    logger::info("Wrote {} trace events to {}", total, path->string());
+}
+} // namespace minskill
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "settings.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace minskill
+{
+// Records named zones into per-thread buffers for a window of time, then writes them
+// as a Chrome / Perfetto trace. Zone names must be string literals.
+class TraceRecorder
+{
+public:
+    static TraceRecorder* getSingleton()
+    {
+        static TraceRecorder recorder;
+        return std::addressof(recorder);
+    }
+
+    ~TraceRecorder();
+
+    // Starts recording if the settings ask for a trace of loading
+    void init(const Settings& settings);
+
+    bool recording() const { return active.load(std::memory_order_acquire); }
+    // Records until stop, or for the given window if there is one
+    void start(std::chrono::milliseconds window = {});
+    // Stops and writes the trace in the background when save is set
+    void stop(bool save = true);
+    // Game thread, ends a timed window
+    void update();
+
+    void record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    struct ZoneTotal
+    {
+        size_t  count    = 0;
+        int64_t total_us = 0;
+    };
+
+    // Events of the latest recording summed by zone name, for benchmarks. Call after stop.
+    std::map<std::string_view, ZoneTotal> totals();
+
+private:
+    static constexpr size_t buffer_size = 1 << 14; // events per thread and recording
+
+    struct Event
+    {
+        const char* name;
+        int64_t     start_us;
+        int64_t     dur_us;
+    };
+
+    struct ThreadBuffer
+    {
+        uint32_t                        tid;
+        std::atomic<uint32_t>           session = 0; // recording the events belong to
+        std::atomic<size_t>             count   = 0; // written by the owning thread only
+        std::array<Event, buffer_size> events;
+    };
+
+    ThreadBuffer* threadBuffer();
+    void          write(uint32_t session);
+
+    std::atomic<bool>                          active  = false;
+    std::atomic<uint32_t>                      session = 0;
+    std::chrono::steady_clock::time_point      epoch;
+    std::chrono::steady_clock::time_point      deadline;
+    std::mutex                                 mutex; // thread registration, writer
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::jthread                               writer;
+};
+
+// Records the enclosing scope while a trace is recording
+class TraceZone
+{
+public:
+    explicit TraceZone(const char* name) : name(name), active(TraceRecorder::getSingleton()->recording())
+    {
+        if (active)
+            start = std::chrono::steady_clock::now();
+    }
+    ~TraceZone() { stop(); }
+
+    // Ends the zone before the scope does
+    void stop()
+    {
+        if (active)
+            TraceRecorder::getSingleton()->record(name, start, std::chrono::steady_clock::now());
+        active = false;
+    }
+
+private:
+    const char*                           name;
+    bool                                  active;
+    std::chrono::steady_clock::time_point start;
+};
+} // namespace minskill
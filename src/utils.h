@@ -1,34 +1,10 @@
 #pragma once
 
-namespace minskill
-{
-union ConditionParam
-{
-    char         c;
-    std::int32_t i;
-    float        f;
-    RE::TESForm* form;
-};
+#include <fstream>
 
-template <class T>
-T* getForm(const std::string& plugin_name, RE::FormID form_id)
+namespace minskill
 {
-    auto data_man = RE::TESDataHandler::GetSingleton();
-    auto result   = data_man->LookupForm(form_id, plugin_name);
-    if (!result)
-    {
-        logger::error("Failed to find form {:x} in {}", form_id, plugin_name);
-        return nullptr;
-    }
-    if (result->formType != T::FORMTYPE)
-    {
-        logger::error("Form {:x} in {} doesn't match the required type!", form_id, plugin_name);
-        return nullptr;
-    }
-    return result->As<T>();
-}
-
-void parseStrList(std::vector<uint16_t>& vec, std::string str)
+inline void parseStrList(std::vector<uint16_t>& vec, std::string str)
 {
     for (auto& chr : str)
         if (chr == ',')
@@ -39,4 +15,15 @@ void parseStrList(std::vector<uint16_t>& vec, std::string str)
         vec.push_back(tmp);
 }
 
+template <class T>
+void writeRaw(std::ofstream& out, const T& val)
+{
+    out.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <class T>
+bool readRaw(std::ifstream& in, T& val)
+{
+    return (bool)in.read(reinterpret_cast<char*>(&val), sizeof(T));
+}
 } // namespace minskill
\ No newline at end of file
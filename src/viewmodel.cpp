@@ -0,0 +1,87 @@
+#include "viewmodel.h"
+#include "file.h"
+
+namespace minskill
+{
+void buildTreeView(const ViewInput& input, TreeViewModel& model)
+{
+    model.gen = input.gen;
+    model.nodes.resize(input.perks.size());
+    for (size_t i = 0; i < input.perks.size(); i++)
+    {
+        const auto& perk_info = *input.perks[i];
+        auto        owned     = input.owned[i];
+        const auto& rank      = perk_info.ranks[std::min<uint8_t>(owned, perk_info.vers - 1)];
+        auto&       node      = model.nodes[i];
+
+        node.owned       = owned;
+        node.label       = rank.name.c_str();
+        node.rank_text   = fmt::format("({}/{})", owned, perk_info.vers);
+        node.skill_text  = std::to_string(rank.skill_req);
+        node.legend_text = std::to_string(rank.legend_req);
+        node.purchasable = input.eligible[i] && input.perk_pts > 0;
+        if (node.purchasable)
+            node.color = input.palette.avail;
+        else
+            node.color = owned ? (owned == perk_info.vers ? input.palette.full : input.palette.partial) : input.palette.none;
+    }
+}
+
+ViewModelBuilder::~ViewModelBuilder()
+{
+    if (worker.joinable())
+    {
+        worker.request_stop();
+        cv.notify_all();
+        worker.join();
+    }
+}
+
+void ViewModelBuilder::request(ViewInput input)
+{
+    {
+        std::lock_guard lock(mutex);
+        auto            slot = input.slot;
+        pending[slot]        = std::move(input);
+        if (!worker.joinable())
+            worker = std::jthread([this](std::stop_token stop) { workerLoop(stop); });
+    }
+    cv.notify_all();
+}
+
+bool ViewModelBuilder::fetch(size_t slot, TreeViewModel& model)
+{
+    std::lock_guard lock(mutex);
+    auto            iter = slots.find(slot);
+    if (iter == slots.end() || iter->second.front.gen <= model.gen)
+        return false;
+    // the old model stays in front until the worker swaps it out as its next back buffer
+    std::swap(model, iter->second.front);
+    return true;
+}
+
+void ViewModelBuilder::workerLoop(std::stop_token stop)
+{
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        cv.wait(lock, stop, [this] { return !pending.empty(); });
+        if (stop.stop_requested())
+            return;
+
+        auto input = std::move(pending.begin()->second);
+        pending.erase(pending.begin());
+        auto& slot = slots[input.slot];
+        auto  back = std::move(slot.back);
+        lock.unlock();
+
+        buildTreeView(input, back);
+
+        lock.lock();
+        // a front that was never fetched is stale once a newer model is done
+        if (back.gen > slot.front.gen)
+            std::swap(slot.front, back);
+        slot.back = std::move(back);
+    }
+}
+} // namespace minskill
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace minskill
+{
+struct Perk;
+
+struct NodePalette
+{
+    ImU32 none;
+    ImU32 partial;
+    ImU32 full;
+    ImU32 avail;
+};
+
+// What the canvas shows for one node
+struct NodeView
+{
+    ImU32       color       = 0;
+    const char* label       = ""; // name of the shown rank, owned by its PerkRank
+    std::string rank_text;        // "(owned/ranks)"
+    std::string skill_text;       // requirements of the shown rank
+    std::string legend_text;
+    uint8_t     owned       = 0;
+    bool        purchasable = false;
+};
+
+struct TreeViewModel
+{
+    uint64_t              gen = 0;
+    std::vector<NodeView> nodes; // by graph index
+};
+
+// State captured by the draw callback, by graph index
+struct ViewInput
+{
+    uint64_t                 gen  = 0;
+    size_t                   slot = 0; // config the model is for
+    NodePalette              palette;
+    long                     perk_pts = 0;
+    std::vector<const Perk*> perks; // only rank data is read, which is fixed after loading
+    std::vector<uint8_t>     owned;
+    std::vector<bool>        eligible;
+};
+
+void buildTreeView(const ViewInput& input, TreeViewModel& model);
+
+// Builds view models on a worker thread, the draw callback swaps in finished ones
+class ViewModelBuilder
+{
+public:
+    static ViewModelBuilder* getSingleton()
+    {
+        static ViewModelBuilder builder;
+        return std::addressof(builder);
+    }
+
+    ~ViewModelBuilder();
+
+    // Replaces any input of the same config that was not built yet
+    void request(ViewInput input);
+    // Swaps in the newest model of the config if it is newer than the given one
+    bool fetch(size_t slot, TreeViewModel& model);
+
+private:
+    struct Slot
+    {
+        TreeViewModel front; // newest finished model, or the one fetch handed back
+        TreeViewModel back;  // only touched by the worker
+    };
+
+    void workerLoop(std::stop_token stop);
+
+    std::mutex                  mutex;
+    std::condition_variable_any cv;
+    std::map<size_t, ViewInput> pending;
+    std::map<size_t, Slot>      slots;
+    std::jthread                worker;
+};
+} // namespace minskill
@@ -0,0 +1,164 @@
+#include "viewstore.h"
+#include "game.h"
+#include "utils.h"
+
+#include <fstream>
+
+namespace minskill
+{
+const auto         view_name    = "MinimalisticSkillMenu.views.bin"sv;
+constexpr uint32_t view_magic   = 0x564B534D; // "MSKV"
+constexpr uint16_t view_version = 1;
+constexpr auto     write_delay  = 1s; // coalesce bursts of changes into one write
+
+bool TreeView::operator==(const TreeView& other) const
+{
+    return zoom == other.zoom && offset.x == other.offset.x && offset.y == other.offset.y &&
+           std::equal(node_pos.begin(), node_pos.end(), other.node_pos.begin(), other.node_pos.end(),
+                      [](const auto& a, const auto& b) { return a.first == b.first && a.second.x == b.second.x && a.second.y == b.second.y; });
+}
+
+ViewStore::~ViewStore()
+{
+    if (writer.joinable())
+    {
+        writer.request_stop();
+        cv.notify_all();
+        writer.join();
+    }
+}
+
+std::optional<TreeView> ViewStore::find(const std::string& key)
+{
+    std::lock_guard lock(mutex);
+    if (!loaded)
+        load();
+    if (auto iter = views.find(key); iter != views.end())
+        return iter->second;
+    return std::nullopt;
+}
+
+void ViewStore::update(const std::string& key, TreeView view)
+{
+    {
+        std::lock_guard lock(mutex);
+        if (!loaded)
+            load();
+        if (auto iter = views.find(key); iter != views.end() && iter->second == view)
+            return;
+        views[key] = std::move(view);
+        dirty      = true;
+        if (!writer.joinable() && !file.empty())
+            writer = std::jthread([this](std::stop_token stop) { writerLoop(stop); });
+    }
+    cv.notify_all();
+}
+
+void ViewStore::load()
+{
+    loaded   = true;
+    auto dir = logDirectory();
+    if (!dir)
+        return; // views are only kept in memory
+    file = *dir / view_name;
+
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+        return;
+
+    uint32_t magic;
+    uint16_t version;
+    uint32_t tree_cts;
+    if (!readRaw(in, magic) || magic != view_magic || !readRaw(in, version) || version != view_version || !readRaw(in, tree_cts))
+    {
+        logger::warn("View file {} is invalid, ignored.", file.string());
+        return;
+    }
+
+    for (uint32_t i = 0; i < tree_cts; i++)
+    {
+        uint16_t key_len;
+        if (!readRaw(in, key_len))
+            break;
+        std::string key(key_len, '\0');
+        in.read(key.data(), key_len);
+
+        TreeView view;
+        uint16_t node_cts;
+        if (!readRaw(in, view.zoom) || !readRaw(in, view.offset) || !readRaw(in, node_cts))
+            break;
+        for (uint16_t j = 0; j < node_cts; j++)
+        {
+            uint16_t num;
+            ImVec2   pos;
+            if (!readRaw(in, num) || !readRaw(in, pos))
+                break;
+            view.node_pos[num] = pos;
+        }
+        if (!in)
+        {
+            logger::warn("View file {} is truncated.", file.string());
+            break;
+        }
+        views[key] = std::move(view);
+    }
+    logger::info("Loaded saved views of {} skill trees.", views.size());
+}
+
+bool ViewStore::save(const std::map<std::string, TreeView>& snapshot)
+{
+    auto          temp_file = std::filesystem::path(file).concat(".tmp");
+    std::ofstream out(temp_file, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+
+    writeRaw(out, view_magic);
+    writeRaw(out, view_version);
+    writeRaw(out, (uint32_t)snapshot.size());
+    for (const auto& [key, view] : snapshot)
+    {
+        writeRaw(out, (uint16_t)key.size());
+        out.write(key.data(), key.size());
+        writeRaw(out, view.zoom);
+        writeRaw(out, view.offset);
+        writeRaw(out, (uint16_t)view.node_pos.size());
+        for (const auto& [num, pos] : view.node_pos)
+        {
+            writeRaw(out, num);
+            writeRaw(out, pos);
+        }
+    }
+    out.close();
+    if (!out)
+        return false;
+
+    std::error_code err;
+    std::filesystem::rename(temp_file, file, err);
+    return !err;
+}
+
+void ViewStore::writerLoop(std::stop_token stop)
+{
+    std::unique_lock lock(mutex);
+    while (true)
+    {
+        cv.wait(lock, stop, [this] { return dirty; });
+        if (!dirty)
+            return; // stopped with nothing pending
+
+        // let the user finish dragging before writing
+        if (!stop.stop_requested())
+            cv.wait_for(lock, stop, write_delay, [] { return false; });
+
+        auto snapshot = views;
+        dirty         = false;
+        lock.unlock();
+        if (!save(snapshot))
+            logger::warn("Failed to write view file {}", file.string());
+        lock.lock();
+
+        if (stop.stop_requested() && !dirty)
+            return;
+    }
+}
+} // namespace minskill
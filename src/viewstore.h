@@ -0,0 +1,48 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace minskill
+{
+struct TreeView
+{
+    float                      zoom = 1.0f;
+    ImVec2                     offset;
+    std::map<uint16_t, ImVec2> node_pos; // only nodes moved away from their config position
+
+    bool operator==(const TreeView& other) const;
+};
+
+// Per-tree pan/zoom and dragged node positions, kept in a small binary file next to the log
+class ViewStore
+{
+public:
+    static ViewStore* getSingleton()
+    {
+        static ViewStore store;
+        return std::addressof(store);
+    }
+
+    ~ViewStore();
+
+    // File is read on first call
+    std::optional<TreeView> find(const std::string& key);
+    // Schedules a background write if the view changed
+    void update(const std::string& key, TreeView view);
+
+private:
+    void load();
+    bool save(const std::map<std::string, TreeView>& snapshot);
+    void writerLoop(std::stop_token stop);
+
+    std::mutex                      mutex;
+    std::condition_variable_any     cv;
+    std::map<std::string, TreeView> views;
+    std::filesystem::path           file; // empty when there is no log directory
+    bool                            loaded = false;
+    bool                            dirty  = false;
+    std::jthread                    writer;
+};
+} // namespace minskill